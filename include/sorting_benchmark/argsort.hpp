@@ -0,0 +1,135 @@
+/** @file
+ *  index sorting: sortings order compact (key, index) pairs instead of
+ *  elements, elements are moved once by the resulting permutation
+ */
+
+#ifndef SORT_BENCH_ARGSORT_HPP
+#define SORT_BENCH_ARGSORT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "sortings.hpp"
+
+namespace srtbch {
+
+namespace sortings {
+
+/** key of element and its position in array, ties of keys are ordered by
+ *  position, so permutation does not depend on stability of sorting
+ */
+template <typename K>
+struct IndexedKey {
+  K key;
+  std::uint32_t index;
+
+  bool operator<(const IndexedKey& other) const {
+    if (key < other.key) return true;
+    if (other.key < key) return false;
+    return index < other.index;
+  }
+  bool operator>(const IndexedKey& other) const { return other < *this; }
+  bool operator<=(const IndexedKey& other) const { return !(other < *this); }
+  bool operator>=(const IndexedKey& other) const { return !(*this < other); }
+  bool operator==(const IndexedKey& other) const {
+    return !(*this < other) && !(other < *this);
+  }
+  bool operator!=(const IndexedKey& other) const { return !(*this == other); }
+};
+
+namespace detail {
+
+/** sortings, that work with keys directly, see only key of the pair, they
+ *  are stable, so ties stay ordered by position
+ */
+template <typename K>
+struct Key<IndexedKey<K>> {
+  using type = typename Key<K>::type;
+  static const type& of(const IndexedKey<K>& elem) noexcept {
+    return Key<K>::of(elem.key);
+  }
+};
+
+/** key_of used by default, element itself is the key, ArrayElement<T> is
+ *  kept, so comparisons of keys are counted in SortBench
+ */
+struct ElementKey {
+  template <typename T>
+  const T& operator()(const T& elem) const noexcept { return elem; }
+};
+
+}  // namespace detail
+
+/** permutation, that sorts data[0, size) by key_of(elem): i-th element of
+ *  sorted array is data[perm[i]], pairs (key, index) are sorted with
+ *  SortFunctor<IndexedKey<key type>>, data is not changed, size should be
+ *  less than 2^32, std::length_error is thrown otherwise
+ */
+template <template <typename> typename SortFunctor, typename T,
+          typename KeyOf = detail::ElementKey>
+std::vector<std::uint32_t> argsort(const T* data, std::size_t size,
+                                   KeyOf key_of = {}) {
+  if (size > std::numeric_limits<std::uint32_t>::max()) {
+    throw std::length_error{"argsort indexes up to 2^32 - 1 elements"};
+  }
+
+  using K = std::decay_t<decltype(key_of(*data))>;
+  std::vector<IndexedKey<K>> keys(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    keys[i] = {key_of(data[i]), static_cast<std::uint32_t>(i)};
+  }
+
+  SortFunctor<IndexedKey<K>>{}(keys.data(), size);
+
+  std::vector<std::uint32_t> perm(size);
+  for (std::size_t i = 0; i < size; ++i) perm[i] = keys[i].index;
+  return perm;
+}
+
+/** reorders data in place so, that data[i] becomes former data[perm[i]]:
+ *  every cycle of permutation is followed from its first position, every
+ *  element is moved once(plus one move to temporary per cycle), perm is used
+ *  to mark visited positions and becomes identity
+ */
+template <typename T>
+void apply_permutation(T* data, std::uint32_t* perm, std::size_t size) {
+  for (std::size_t i = 0; i < size; ++i) {
+    if (perm[i] == i) continue;
+
+    T tmp = std::move(data[i]);
+    std::size_t pos = i;
+    while (perm[pos] != i) {
+      std::size_t from = perm[pos];
+      data[pos] = std::move(data[from]);
+      perm[pos] = static_cast<std::uint32_t>(pos);
+      pos = from;
+    }
+    data[pos] = std::move(tmp);
+    perm[pos] = static_cast<std::uint32_t>(pos);
+  }
+}
+
+/** sorts elements by their keys through argsort() with SortFunctor and
+ *  apply_permutation(), for wide elements, that are expensive to move, keys
+ *  are taken by default constructed KeyOf, it should return narrow key of
+ *  wide element, otherwise the whole element is copied to every pair
+ */
+template <typename T, template <typename> typename SortFunctor = PdqSort,
+          typename KeyOf = detail::ElementKey>
+struct IndirectSort {
+  void operator()(T* data, std::size_t size) const {
+    auto perm{argsort<SortFunctor>(data, size, KeyOf{})};
+    apply_permutation(data, perm.data(), size);
+  }
+};
+
+}  // namespace sortings
+
+}  // namespace srtbch
+
+#endif  // SORT_BENCH_ARGSORT_HPP
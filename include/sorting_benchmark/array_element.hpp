@@ -5,21 +5,27 @@ template class declaration for comparisons and assignments counting
 #ifndef SORT_BENCH_ARRAY_ELEMENT_HPP
 #define SORT_BENCH_ARRAY_ELEMENT_HPP
 
+#include <atomic>
 #include <utility>
 
 namespace srtbch {
 
-/** class for comparison and assignment counting */
+/** class for comparison and assignment counting, counters are atomic, so
+ *  multithreaded sortings are counted correctly
+ */
 
 template <typename T>
 class ArrayElement {
   T elem_{};
 
-  static std::size_t comparisons;  ///< 0 by default
-  static std::size_t assignments;  ///< 0 by default
+  static std::atomic<std::size_t> comparisons;  ///< 0 by default
+  static std::atomic<std::size_t> assignments;  ///< 0 by default
 
-  static bool cmp_on;   ///< true by default
-  static bool asgn_on;  ///< true by default
+  static std::atomic<bool> cmp_on;   ///< true by default
+  static std::atomic<bool> asgn_on;  ///< true by default
+
+  static void count(std::atomic<std::size_t> &counter,
+                    const std::atomic<bool> &on) noexcept;
  public:
   ArrayElement() = default;
   ArrayElement(const ArrayElement &) = default;
@@ -40,6 +46,8 @@ class ArrayElement {
   static void cmp_count_switch(bool) noexcept;
   static void asgn_count_switch(bool) noexcept;
 
+  const T &value() const noexcept;
+
   bool operator==(const ArrayElement &other) const;
   bool operator!=(const ArrayElement &other) const;
   bool operator>(const ArrayElement &other) const;
@@ -49,16 +57,24 @@ class ArrayElement {
 };
 
 template <typename T>
-std::size_t ArrayElement<T>::comparisons = 0;
+std::atomic<std::size_t> ArrayElement<T>::comparisons{0};
+
+template <typename T>
+std::atomic<std::size_t> ArrayElement<T>::assignments{0};
 
 template <typename T>
-std::size_t ArrayElement<T>::assignments = 0;
+std::atomic<bool> ArrayElement<T>::cmp_on{true};
 
 template <typename T>
-bool ArrayElement<T>::cmp_on = true;
+std::atomic<bool> ArrayElement<T>::asgn_on{true};
 
 template <typename T>
-bool ArrayElement<T>::asgn_on = true;
+inline void ArrayElement<T>::count(std::atomic<std::size_t> &counter,
+                                   const std::atomic<bool> &on) noexcept {
+  if (on.load(std::memory_order_relaxed)) {
+    counter.fetch_add(1, std::memory_order_relaxed);
+  }
+}
 
 template <typename T>
 ArrayElement<T>::ArrayElement(const T &el) : elem_{el} {}
@@ -68,7 +84,7 @@ ArrayElement<T>::ArrayElement(T &&el) : elem_{std::move(el)} {}
 
 template <typename T>
 ArrayElement<T> &ArrayElement<T>::operator=(const ArrayElement<T> &el) {
-  if (asgn_on) assignments++;
+  count(assignments, asgn_on);
   elem_ = el.elem_;
 
   return (*this);
@@ -76,7 +92,7 @@ ArrayElement<T> &ArrayElement<T>::operator=(const ArrayElement<T> &el) {
 
 template <typename T>
 ArrayElement<T> &ArrayElement<T>::operator=(const T &el) {
-  if (asgn_on) assignments++;
+  count(assignments, asgn_on);
   elem_ = el;
 
   return (*this);
@@ -84,7 +100,7 @@ ArrayElement<T> &ArrayElement<T>::operator=(const T &el) {
 
 template <typename T>
 ArrayElement<T> &ArrayElement<T>::operator=(ArrayElement<T> &&el) {
-  if (asgn_on) assignments++;
+  count(assignments, asgn_on);
   elem_ = std::move(el.elem_);
 
   return (*this);
@@ -92,7 +108,7 @@ ArrayElement<T> &ArrayElement<T>::operator=(ArrayElement<T> &&el) {
 
 template <typename T>
 ArrayElement<T> &ArrayElement<T>::operator=(T &&el) {
-  if (asgn_on) assignments++;
+  count(assignments, asgn_on);
   elem_ = std::move(el);
 
   return (*this);
@@ -124,39 +140,45 @@ inline void ArrayElement<T>::asgn_count_switch(bool b) noexcept {
   asgn_on = b;
 }
 
+/** access to wrapped element, neither comparison nor assignment counted */
+template <typename T>
+inline const T &ArrayElement<T>::value() const noexcept {
+  return elem_;
+}
+
 template <typename T>
 inline bool ArrayElement<T>::operator==(const ArrayElement<T> &other) const {
-  if (cmp_on) comparisons++;
+  count(comparisons, cmp_on);
   return elem_ == other.elem_;
 }
 
 template <typename T>
 inline bool ArrayElement<T>::operator!=(const ArrayElement<T> &other) const {
-  if (cmp_on) comparisons++;
+  count(comparisons, cmp_on);
   return elem_ != other.elem_;
 }
 
 template <typename T>
 inline bool ArrayElement<T>::operator>(const ArrayElement<T> &other) const {
-  if (cmp_on) comparisons++;
+  count(comparisons, cmp_on);
   return elem_ > other.elem_;
 }
 
 template <typename T>
 inline bool ArrayElement<T>::operator<(const ArrayElement<T> &other) const {
-  if (cmp_on) comparisons++;
+  count(comparisons, cmp_on);
   return elem_ < other.elem_;
 }
 
 template <typename T>
 inline bool ArrayElement<T>::operator>=(const ArrayElement<T> &other) const {
-  if (cmp_on) comparisons++;
+  count(comparisons, cmp_on);
   return elem_ >= other.elem_;
 }
 
 template <typename T>
 inline bool ArrayElement<T>::operator<=(const ArrayElement<T> &other) const {
-  if (cmp_on) comparisons++;
+  count(comparisons, cmp_on);
   return elem_ <= other.elem_;
 }
 
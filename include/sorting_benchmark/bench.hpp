@@ -6,3 +6,7 @@
 #include "sorting_benchmark.hpp"
 #include "utility.hpp"
 #include "sortings.hpp"
+#include "thread_pool.hpp"
+#include "parallel_sortings.hpp"
+#include "simd_sortings.hpp"
+#include "argsort.hpp"
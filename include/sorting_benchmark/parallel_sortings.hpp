@@ -0,0 +1,785 @@
+/** @file
+ *  multithreaded sortings, running on ThreadPool
+ */
+
+#ifndef SORT_BENCH_PARALLEL_SORTINGS_HPP
+#define SORT_BENCH_PARALLEL_SORTINGS_HPP
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "sortings.hpp"
+#include "thread_pool.hpp"
+
+namespace srtbch {
+
+namespace sortings {
+
+namespace detail {
+
+/** stable merge of [first1, last1) and [first2, last2) to dest, elements are
+ *  moved
+ */
+template <typename T>
+void merge_to(T* first1, T* last1, T* first2, T* last2, T* dest) {
+  while (first1 != last1 && first2 != last2) {
+    if (*first2 < *first1) {
+      *dest++ = std::move(*first2++);
+    } else {
+      *dest++ = std::move(*first1++);
+    }
+  }
+  dest = std::move(first1, last1, dest);
+  std::move(first2, last2, dest);
+}
+
+/** amount of elements of a, that go to the first k elements of stable merge
+ *  of a[0, n1) and b[0, n2)(merge path / co-rank split)
+ */
+template <typename T>
+std::size_t co_rank(std::size_t k, const T* a, std::size_t n1, const T* b,
+                    std::size_t n2) {
+  std::size_t lo = k > n2 ? k - n2 : 0;
+  std::size_t hi = std::min(k, n1);
+
+  while (lo < hi) {
+    std::size_t i = lo + (hi - lo) / 2;
+    std::size_t j = k - i;
+    // a[i] goes before b[j - 1](a wins ties), so more of a is taken
+    if (j > 0 && !(b[j - 1] < a[i])) {
+      lo = i + 1;
+    } else {
+      hi = i;
+    }
+  }
+
+  return lo;
+}
+
+/** stable merge of a[0, n1) and b[0, n2) to dest, output is split to chunks
+ *  by co_rank, and chunks are merged in parallel
+ */
+template <typename T>
+void parallel_merge_to(ThreadPool& pool, T* a, std::size_t n1, T* b,
+                       std::size_t n2, T* dest, std::size_t grain) {
+  std::size_t total = n1 + n2;
+  std::size_t chunks = std::min(pool.concurrency(), total / grain);
+  if (chunks < 2) return merge_to(a, a + n1, b, b + n2, dest);
+
+  TaskGroup group{pool};
+  for (std::size_t c = 0; c < chunks; ++c) {
+    group.run([=] {
+      std::size_t k_lo = total * c / chunks;
+      std::size_t k_hi = total * (c + 1) / chunks;
+      std::size_t i_lo = co_rank(k_lo, a, n1, b, n2);
+      std::size_t i_hi = co_rank(k_hi, a, n1, b, n2);
+
+      merge_to(a + i_lo, a + i_hi, b + (k_lo - i_lo), b + (k_hi - i_hi),
+               dest + k_lo);
+    });
+  }
+  group.wait();
+}
+
+/** runs func(c) for every chunk c in [0, chunks) as pool tasks */
+template <typename Func>
+void for_chunks(ThreadPool& pool, std::size_t chunks, Func func) {
+  TaskGroup group{pool};
+  for (std::size_t c = 0; c < chunks; ++c) {
+    group.run([&func, c] { func(c); });
+  }
+  group.wait();
+}
+
+}  // namespace detail
+
+/** stable parallel merge sort: halves are sorted as pool tasks(ping-pong
+ *  between array and one scratch buffer), large merges are split between
+ *  threads by co-rank, ranges up to grain elements are sorted sequentially
+ *  with MergeSort, pool is ThreadPool::instance() unless given, scratch
+ *  buffer is kept between calls, so one object must not sort in two threads
+ *  at once(every calling thread needs its own)
+ */
+template <typename T>
+struct ParallelMergeSort {
+  static constexpr std::size_t default_grain = std::size_t{1} << 14;
+
+  ParallelMergeSort() : ParallelMergeSort(ThreadPool::instance()) {}
+  explicit ParallelMergeSort(ThreadPool& pool,
+                             std::size_t grain = default_grain)
+      : pool_{&pool}, grain_{std::max<std::size_t>(grain, 2)} {}
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    if (buffer_.size() < size) buffer_.resize(size);
+    sort(data, buffer_.data(), size, false);
+  }
+
+ private:
+  ThreadPool* pool_;
+  std::size_t grain_;
+  mutable std::vector<T> buffer_;  ///< not shared between threads, see above
+
+  /** sorts data[0, size), result goes to buffer if to_buffer, buffer is
+   *  used as scratch otherwise
+   */
+  void sort(T* data, T* buffer, std::size_t size, bool to_buffer) const {
+    if (size <= grain_) {
+      MergeSort<T>{buffer, size}(data, size);
+      if (to_buffer) std::move(data, data + size, buffer);
+      return;
+    }
+
+    std::size_t half = size / 2;
+    {
+      TaskGroup group{*pool_};
+      group.run([=] { sort(data, buffer, half, !to_buffer); });
+      sort(data + half, buffer + half, size - half, !to_buffer);
+      group.wait();
+    }
+
+    // sorted halves are where the result should not be
+    T* from = to_buffer ? data : buffer;
+    T* to = to_buffer ? buffer : data;
+    detail::parallel_merge_to(*pool_, from, half, from + half, size - half, to,
+                              grain_);
+  }
+};
+
+/** parallel quicksort: both parts of every partition are sorted as pool
+ *  tasks, ranges of at least parallel_partition_threshold elements are
+ *  partitioned by all threads in place(every thread partitions its chunk, then
+ *  misplaced elements are swapped in parallel), ranges up to grain elements are
+ *  sorted sequentially with QuickSort(introsort)
+ */
+template <typename T>
+struct ParallelQuickSort {
+  static constexpr std::size_t default_grain = std::size_t{1} << 14;
+  static constexpr std::size_t parallel_partition_threshold = std::size_t{1}
+                                                              << 17;
+
+  ParallelQuickSort() : ParallelQuickSort(ThreadPool::instance()) {}
+  explicit ParallelQuickSort(ThreadPool& pool,
+                             std::size_t grain = default_grain)
+      : pool_{&pool}, grain_{std::max<std::size_t>(grain, 2)} {}
+
+  void operator()(T* data, std::size_t size) const {
+    return sort(data, size, 2 * detail::log2(size));
+  }
+
+ private:
+  ThreadPool* pool_;
+  std::size_t grain_;
+
+  void sort(T* data, std::size_t size, std::size_t depth) const {
+    if (size <= grain_ || depth == 0) return QuickSort<T>{}(data, size);
+
+    auto [left_end, right_begin] = partition(data, size);
+
+    TaskGroup group{*pool_};
+    group.run([=] { sort(data, left_end, depth - 1); });
+    sort(data + right_begin, size - right_begin, depth - 1);
+    group.wait();
+  }
+
+  /** partitions data, returns end of the left part and begin of the right
+   *  one, elements between them are in place
+   */
+  std::pair<std::size_t, std::size_t> partition(T* data,
+                                                std::size_t size) const {
+    if (size < parallel_partition_threshold || pool_->concurrency() < 2) {
+      std::size_t pi = QuickSort<T>{}.partition(data, 0, size - 1);
+      return {pi, pi + 1};
+    }
+
+    T pivot = data[QuickSort<T>::select_pivot(data, 0, size - 1)];
+    std::size_t less = parallel_partition(
+        data, size, [&pivot](const T& elem) { return elem < pivot; });
+    if (less > 0) return {less, less};
+
+    // pivot is the least, elements equal to it are split off for progress
+    std::size_t not_greater = parallel_partition(
+        data, size, [&pivot](const T& elem) { return !(pivot < elem); });
+    return {0, not_greater};
+  }
+
+  /** in place partition by all threads, returns amount of elements, that
+   *  satisfy pred(they go first)
+   */
+  template <typename Pred>
+  std::size_t parallel_partition(T* data, std::size_t size, Pred pred) const {
+    std::size_t chunks = std::min(pool_->concurrency(), size / grain_);
+    std::vector<std::size_t> bounds(chunks + 1), splits(chunks);
+    for (std::size_t c = 0; c <= chunks; ++c) bounds[c] = size * c / chunks;
+
+    {
+      TaskGroup group{*pool_};
+      for (std::size_t c = 0; c < chunks; ++c) {
+        group.run([&, c] {
+          T* split =
+              std::partition(data + bounds[c], data + bounds[c + 1], pred);
+          splits[c] = static_cast<std::size_t>(split - data);
+        });
+      }
+      group.wait();
+    }
+
+    std::size_t total = 0;
+    for (std::size_t c = 0; c < chunks; ++c) total += splits[c] - bounds[c];
+
+    // misplaced elements: not satisfying pred before total and satisfying
+    // after it, both lists of intervals are ordered and of the same length,
+    // empty intervals are not kept, swap_misplaced steps over one at a time
+    std::vector<Interval> wrong_left, wrong_right;
+    for (std::size_t c = 0; c < chunks; ++c) {
+      std::size_t left_end = std::min(bounds[c + 1], total);
+      if (splits[c] < left_end) wrong_left.push_back({splits[c], left_end});
+
+      std::size_t right_begin = std::max(bounds[c], total);
+      if (right_begin < splits[c]) {
+        wrong_right.push_back({right_begin, splits[c]});
+      }
+    }
+    std::size_t misplaced = prefix_offsets(wrong_left);
+    prefix_offsets(wrong_right);
+    if (misplaced == 0) return total;
+
+    std::size_t parts = std::min(pool_->concurrency(), misplaced / grain_ + 1);
+    TaskGroup group{*pool_};
+    for (std::size_t p = 0; p < parts; ++p) {
+      group.run([&, p] {
+        std::size_t lo = misplaced * p / parts;
+        std::size_t hi = misplaced * (p + 1) / parts;
+        swap_misplaced(data, wrong_left, wrong_right, lo, hi);
+      });
+    }
+    group.wait();
+
+    return total;
+  }
+
+  /** positions [begin, end), offset is amount of misplaced elements before
+   *  the interval
+   */
+  struct Interval {
+    std::size_t begin;
+    std::size_t end;
+    std::size_t offset{0};
+  };
+
+  static std::size_t prefix_offsets(std::vector<Interval>& intervals) {
+    std::size_t offset = 0;
+    for (auto& interval : intervals) {
+      interval.offset = offset;
+      offset += interval.end - interval.begin;
+    }
+    return offset;
+  }
+
+  /** position of k-th misplaced element */
+  static std::pair<std::size_t, std::size_t> locate(
+      const std::vector<Interval>& intervals, std::size_t k) {
+    auto it = std::upper_bound(
+        intervals.begin(), intervals.end(), k,
+        [](std::size_t key, const Interval& in) { return key < in.offset; });
+    --it;
+    return {static_cast<std::size_t>(it - intervals.begin()),
+            it->begin + (k - it->offset)};
+  }
+
+  /** swaps misplaced elements with numbers [lo, hi) */
+  static void swap_misplaced(T* data, const std::vector<Interval>& left,
+                             const std::vector<Interval>& right,
+                             std::size_t lo, std::size_t hi) {
+    if (lo == hi) return;
+
+    auto [li, lpos] = locate(left, lo);
+    auto [ri, rpos] = locate(right, lo);
+    for (std::size_t k = lo; k < hi; ++k) {
+      if (lpos == left[li].end) lpos = left[++li].begin;
+      if (rpos == right[ri].end) rpos = right[++ri].begin;
+
+      std::swap(data[lpos++], data[rpos++]);
+    }
+  }
+};
+
+/** parallel sample sort: splitters are chosen from sorted random sample,
+ *  threads classify their chunks by branchless search tree and scatter them
+ *  to buckets(through scratch buffer), then buckets are sorted as pool tasks
+ *  with QuickSort, keys repeated in sample get buckets of their own, that are
+ *  not sorted, durations of phases are recorded for every call(they and
+ *  scratch buffers are kept in the object, so it must not sort in two
+ *  threads at once)
+ */
+template <typename T>
+struct ParallelSampleSort {
+  static constexpr std::size_t default_grain = std::size_t{1} << 14;
+  static constexpr std::size_t max_buckets = 256;
+  static constexpr std::size_t buckets_per_thread = 8;
+  static constexpr std::size_t oversampling = 16;  ///< samples per bucket
+
+  /** durations of phases of one call, arrays up to grain elements are
+   *  sorted at once(bucket_sorting only)
+   */
+  struct PhaseTimes {
+    std::chrono::nanoseconds sampling{0};
+    std::chrono::nanoseconds classification{0};
+    std::chrono::nanoseconds scattering{0};
+    std::chrono::nanoseconds bucket_sorting{0};
+  };
+
+  ParallelSampleSort() : ParallelSampleSort(ThreadPool::instance()) {}
+  explicit ParallelSampleSort(ThreadPool& pool,
+                              std::size_t grain = default_grain)
+      : pool_{&pool}, grain_{std::max<std::size_t>(grain, 2)} {}
+
+  void operator()(T* data, std::size_t size) const {
+    using clock = std::chrono::steady_clock;
+    clock::time_point mark{clock::now()};
+    auto lap = [&mark] {
+      clock::time_point now{clock::now()};
+      return std::chrono::nanoseconds(now - std::exchange(mark, now));
+    };
+
+    PhaseTimes times;
+    if (size <= grain_) {
+      QuickSort<T>{}(data, size);
+      times.bucket_sorting = lap();
+      phases_.push_back(times);
+      return;
+    }
+
+    Classifier classifier{sample(data, size)};
+    times.sampling = lap();
+
+    std::size_t chunks = std::min(pool_->concurrency(), size / grain_);
+    std::size_t buckets = classifier.buckets();
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t c = 0; c <= chunks; ++c) bounds[c] = size * c / chunks;
+
+    // positions of buckets of every chunk, counts at first
+    std::vector<std::size_t> offsets(chunks * buckets, 0);
+    if (oracle_.size() < size) oracle_.resize(size);
+    std::uint16_t* oracle = oracle_.data();
+    detail::for_chunks(*pool_, chunks, [&](std::size_t c) {
+      std::size_t* counts = offsets.data() + c * buckets;
+      for (std::size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+        std::size_t b = classifier(data[i]);
+        oracle[i] = static_cast<std::uint16_t>(b);
+        ++counts[b];
+      }
+    });
+    times.classification = lap();
+
+    std::vector<std::size_t> bucket_bounds(buckets + 1, 0);
+    for (std::size_t b = 0, pos = 0; b < buckets; ++b) {
+      bucket_bounds[b] = pos;
+      for (std::size_t c = 0; c < chunks; ++c) {
+        std::size_t count = offsets[c * buckets + b];
+        offsets[c * buckets + b] = pos;
+        pos += count;
+      }
+    }
+    bucket_bounds[buckets] = size;
+
+    if (buffer_.size() < size) buffer_.resize(size);
+    T* buffer = buffer_.data();
+    detail::for_chunks(*pool_, chunks, [&](std::size_t c) {
+      std::size_t* positions = offsets.data() + c * buckets;
+      for (std::size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+        buffer[positions[oracle[i]]++] = std::move(data[i]);
+      }
+    });
+    times.scattering = lap();
+
+    // buckets go back to their places in data, and are sorted there
+    TaskGroup group{*pool_};
+    for (std::size_t b = 0; b < buckets; ++b) {
+      std::size_t begin = bucket_bounds[b];
+      std::size_t end = bucket_bounds[b + 1];
+      if (begin == end) continue;
+
+      bool sorted = classifier.is_equal_bucket(b);
+      group.run([=] {
+        std::move(buffer + begin, buffer + end, data + begin);
+        if (!sorted) QuickSort<T>{}(data + begin, end - begin);
+      });
+    }
+    group.wait();
+    times.bucket_sorting = lap();
+
+    phases_.push_back(times);
+  }
+
+  /** phase durations of every call in order of calls */
+  const std::vector<PhaseTimes>& phase_times() const noexcept {
+    return phases_;
+  }
+
+  void clear_phase_times() noexcept { phases_.clear(); }
+
+ private:
+  ThreadPool* pool_;
+  std::size_t grain_;
+  mutable std::vector<T> buffer_;
+  mutable std::vector<std::uint16_t> oracle_;  ///< bucket of every element
+  mutable std::vector<PhaseTimes> phases_;
+
+  /** finds bucket of element by implicit binary search tree of splitters
+   *  (in Eytzinger order, tree[1] is the root), without branches
+   */
+  struct Classifier {
+    std::vector<T> tree;
+    std::vector<T> splitters;  ///< sorted, padded to tree size
+    std::size_t levels;
+    bool equal_buckets;
+
+    /** splitters - sorted and unique, equal_buckets - whether there should
+     *  be bucket for every splitter, with elements equal to it
+     */
+    Classifier(std::vector<T> unique, bool equal)
+        : levels{detail::log2(unique.size()) + 1}, equal_buckets{equal} {
+      std::size_t tree_size = std::size_t{1} << levels;
+      unique.resize(tree_size - 1, unique.back());
+      splitters = std::move(unique);
+      tree.resize(tree_size);
+      build(1, 0, tree_size - 1);
+    }
+
+    std::size_t buckets() const noexcept {
+      return (std::size_t{1} << levels) << equal_buckets;
+    }
+
+    bool is_equal_bucket(std::size_t bucket) const noexcept {
+      return equal_buckets && bucket % 2 == 1;
+    }
+
+    /** bucket b holds elements in (splitters[b - 1], splitters[b]], with
+     *  equal buckets it is split to 2 * b and 2 * b + 1(equal to
+     *  splitters[b])
+     */
+    std::size_t operator()(const T& elem) const {
+      std::size_t b = 1;
+      for (std::size_t l = 0; l < levels; ++l) {
+        b = 2 * b + static_cast<std::size_t>(tree[b] < elem);
+      }
+      b -= tree.size();
+      if (!equal_buckets) return b;
+
+      // the last bucket has no upper splitter, elements there are greater
+      const T& upper = splitters[std::min(b, splitters.size() - 1)];
+      return 2 * b + static_cast<std::size_t>(!(elem < upper) &
+                                              !(upper < elem));
+    }
+
+   private:
+    /** node gets middle of splitters[lo, hi), subtrees - halves */
+    void build(std::size_t node, std::size_t lo, std::size_t hi) {
+      if (lo == hi) return;
+
+      std::size_t mid = lo + (hi - lo) / 2;
+      tree[node] = splitters[mid];
+      build(2 * node, lo, mid);
+      build(2 * node + 1, mid + 1, hi);
+    }
+  };
+
+  /** moves random sample to the front of data, sorts it and picks
+   *  splitters from it
+   */
+  Classifier sample(T* data, std::size_t size) const {
+    std::size_t buckets = std::max<std::size_t>(
+        2, std::min({max_buckets, buckets_per_thread * pool_->concurrency(),
+                     size / grain_}));
+    std::size_t sample_size = std::min(size, buckets * oversampling);
+
+    std::mt19937_64 rng{size};
+    for (std::size_t i = 0; i < sample_size; ++i) {
+      std::swap(data[i], data[i + rng() % (size - i)]);
+    }
+    QuickSort<T>{}(data, sample_size);
+
+    std::vector<T> splitters;
+    std::size_t step = sample_size / buckets;
+    for (std::size_t i = 1; i < buckets; ++i) {
+      splitters.push_back(data[i * step - 1]);
+    }
+    std::size_t picked = splitters.size();
+    splitters.erase(std::unique(std::begin(splitters), std::end(splitters),
+                                [](const T& lhs, const T& rhs) {
+                                  return !(lhs < rhs);
+                                }),
+                    std::end(splitters));
+
+    // repeated splitter is a frequent key, it gets bucket of its own
+    bool equal_buckets = splitters.size() < picked;
+    return {std::move(splitters), equal_buckets};
+  }
+};
+
+/** parallel LSD radix sort, byte per pass: every thread counts digits of its
+ *  chunk, prefix sums across threads give every thread its own positions for
+ *  every digit, then threads scatter their chunks, elements are gathered to
+ *  cache line sized write-combining buffers first, full lines are written at
+ *  once(with non-temporal stores if NonTemporal, for trivially copyable T on
+ *  SSE2), passes with the same digit in every element are skipped, scratch
+ *  buffer is kept in the object, so it must not sort in two threads at once
+ */
+template <typename T, bool NonTemporal = false>
+struct ParallelRadixSort {
+  using K = typename detail::Key<T>::type;
+  static_assert(std::is_integral_v<K> && !std::is_same_v<K, bool>,
+                "ParallelRadixSort requires integral keys");
+
+  static constexpr std::size_t default_grain = std::size_t{1} << 16;
+  static constexpr std::size_t line_bytes = 64;
+
+  ParallelRadixSort() : ParallelRadixSort(ThreadPool::instance()) {}
+  explicit ParallelRadixSort(ThreadPool& pool,
+                             std::size_t grain = default_grain)
+      : pool_{&pool}, grain_{std::max<std::size_t>(grain, 2)} {}
+
+  void operator()(T* data, std::size_t size) const {
+    if (size <= grain_) return RadixSort<T>{}(data, size);
+
+    std::size_t chunks = std::min(pool_->concurrency(), size / grain_);
+    std::vector<std::size_t> bounds(chunks + 1);
+    for (std::size_t c = 0; c <= chunks; ++c) bounds[c] = size * c / chunks;
+
+    // digits of every pass are counted in one go, to skip passes, counts
+    // of chunks are valid for the first pass only
+    std::vector<Counts> counts(chunks * passes);
+    detail::for_chunks(*pool_, chunks, [&](std::size_t c) {
+      Counts* chunk_counts = counts.data() + c * passes;
+      for (std::size_t p = 0; p < passes; ++p) chunk_counts[p].fill(0);
+      for (std::size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+        U key = Radix::of(data[i]);
+        for (std::size_t p = 0; p < passes; ++p) {
+          ++chunk_counts[p][Radix::digit(key, p)];
+        }
+      }
+    });
+
+    T* src = data;
+    T* dst = nullptr;
+    U first = Radix::of(data[0]);
+    std::vector<Counts> positions(chunks);
+
+    for (std::size_t p = 0; p < passes; ++p) {
+      std::size_t same = 0;
+      for (std::size_t c = 0; c < chunks; ++c) {
+        same += counts[c * passes + p][Radix::digit(first, p)];
+      }
+      if (same == size) continue;
+
+      if (dst == nullptr) {
+        if (buffer_.size() < size) buffer_.resize(size);
+        dst = buffer_.data();
+      } else {
+        detail::for_chunks(*pool_, chunks, [&](std::size_t c) {
+          Counts& chunk_counts = counts[c * passes + p];
+          chunk_counts.fill(0);
+          for (std::size_t i = bounds[c]; i < bounds[c + 1]; ++i) {
+            ++chunk_counts[Radix::digit(Radix::of(src[i]), p)];
+          }
+        });
+      }
+
+      // digit goes after smaller ones, chunk - after previous chunks
+      std::size_t sum = 0;
+      for (std::size_t d = 0; d < radix; ++d) {
+        for (std::size_t c = 0; c < chunks; ++c) {
+          positions[c][d] = sum;
+          sum += counts[c * passes + p][d];
+        }
+      }
+
+      detail::for_chunks(*pool_, chunks, [&](std::size_t c) {
+        scatter(src + bounds[c], src + bounds[c + 1], dst, p, positions[c]);
+      });
+
+      std::swap(src, dst);
+    }
+
+    if (src != data) {
+      detail::for_chunks(*pool_, chunks, [&](std::size_t c) {
+        std::move(src + bounds[c], src + bounds[c + 1], data + bounds[c]);
+      });
+    }
+  }
+
+ private:
+  using Radix = detail::RadixKey<T>;
+  using U = typename Radix::U;
+  using Counts = std::array<std::size_t, Radix::radix>;
+
+  static constexpr std::size_t radix = Radix::radix;
+  static constexpr std::size_t passes = Radix::passes;
+
+  /** elements in write-combining buffer of one digit */
+  static constexpr std::size_t line_size =
+      sizeof(T) < line_bytes ? line_bytes / sizeof(T) : 1;
+  static constexpr bool streaming =
+      NonTemporal && std::is_trivially_copyable_v<T> &&
+      line_bytes % sizeof(T) == 0;
+
+  ThreadPool* pool_;
+  std::size_t grain_;
+  mutable std::vector<T> buffer_;
+
+  /** moves [first, last) to dst by digit of pass, positions - where next
+   *  element with every digit goes, buffer slot of element is its position in
+   *  cache line of dst, so full buffer is written as aligned line
+   */
+  static void scatter(T* first, T* last, T* dst, std::size_t pass,
+                      Counts& positions) {
+    std::vector<T> lines(radix * line_size);
+    Counts begins{positions};
+    std::size_t base = reinterpret_cast<std::uintptr_t>(dst) / sizeof(T);
+
+    for (; first != last; ++first) {
+      std::size_t d = Radix::digit(Radix::of(*first), pass);
+      std::size_t pos = positions[d]++;
+      std::size_t slot = (base + pos) % line_size;
+
+      lines[d * line_size + slot] = std::move(*first);
+      if (slot == line_size - 1) {
+        std::size_t count = std::min(line_size, pos + 1 - begins[d]);
+        flush(lines.data() + d * line_size, line_size - count, dst,
+              pos + 1 - count, pos + 1);
+      }
+    }
+
+    // rest of the last line of every digit
+    for (std::size_t d = 0; d < radix; ++d) {
+      std::size_t end = positions[d];
+      std::size_t slot = (base + end) % line_size;
+      std::size_t count = std::min(slot, end - begins[d]);
+      flush(lines.data() + d * line_size, slot - count, dst, end - count, end);
+    }
+
+#if defined(__SSE2__)
+    if constexpr (streaming) _mm_sfence();
+#endif
+  }
+
+  /** writes elements of line from slot to dst[from, to), parts of line,
+   *  that belong to other threads or digits, are not touched
+   */
+  static void flush(T* line, std::size_t slot, T* dst, std::size_t from,
+                    std::size_t to) {
+#if defined(__SSE2__)
+    if constexpr (streaming) {
+      if (to - from == line_size) {
+        auto* out = reinterpret_cast<__m128i*>(dst + from);
+        const auto* in = reinterpret_cast<const __m128i*>(line);
+        for (std::size_t k = 0; k < line_bytes / sizeof(__m128i); ++k) {
+          _mm_stream_si128(out + k, _mm_loadu_si128(in + k));
+        }
+        return;
+      }
+    }
+#endif
+    std::move(line + slot, line + slot + (to - from), dst + from);
+  }
+};
+
+/** ParallelRadixSort, that writes full lines with non-temporal stores */
+template <typename T>
+using NonTemporalRadixSort = ParallelRadixSort<T, true>;
+
+/** sorts many independent segments of one buffer, segment i is
+ *  data[offsets[i], offsets[i + 1]), by size classes: segments up to
+ *  NetworkSort<T>::max_size elements are sorted by networks, up to huge_size
+ *  by QuickSort(introsort) in pool tasks, larger ones by ParallelQuickSort on
+ *  the same pool, one after another; runs of adjacent small and medium
+ *  segments are packed into tasks of about the same cost(n log n), several
+ *  per thread, so threads stay balanced through work stealing
+ */
+template <typename T>
+struct SegmentedSort {
+  static constexpr std::size_t default_grain = std::size_t{1} << 14;
+  static constexpr std::size_t huge_size = std::size_t{1} << 17;
+  static constexpr std::size_t tasks_per_thread = 4;
+
+  SegmentedSort() : SegmentedSort(ThreadPool::instance()) {}
+  explicit SegmentedSort(ThreadPool& pool, std::size_t grain = default_grain)
+      : pool_{&pool}, grain_{std::max<std::size_t>(grain, 2)} {}
+
+  void operator()(T* data, const std::size_t* offsets,
+                  std::size_t segments) const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < segments; ++i) {
+      std::size_t size = offsets[i + 1] - offsets[i];
+      if (size < huge_size) total += cost(size);
+    }
+    std::size_t task_cost = std::max(
+        grain_, total / (tasks_per_thread * pool_->concurrency() + 1));
+
+    TaskGroup group{*pool_};
+    std::size_t first = 0, run_cost = 0;
+    for (std::size_t i = 0; i < segments; ++i) {
+      std::size_t size = offsets[i + 1] - offsets[i];
+      if (size < huge_size) run_cost += cost(size);
+      if (run_cost < task_cost && i + 1 < segments) continue;
+
+      group.run([=] { sort_run(data, offsets, first, i + 1); });
+      first = i + 1;
+      run_cost = 0;
+    }
+
+    // threads take the runs, while this one splits huge segments
+    ParallelQuickSort<T> parallel_sort{*pool_, grain_};
+    for (std::size_t i = 0; i < segments; ++i) {
+      std::size_t size = offsets[i + 1] - offsets[i];
+      if (size >= huge_size) parallel_sort(data + offsets[i], size);
+    }
+    group.wait();
+  }
+
+  /** whole array is one segment */
+  void operator()(T* data, std::size_t size) const {
+    const std::size_t offsets[] = {0, size};
+    (*this)(data, offsets, 1);
+  }
+
+ private:
+  ThreadPool* pool_;
+  std::size_t grain_;
+
+  static std::size_t cost(std::size_t size) noexcept {
+    return size * (detail::log2(size + 1) + 1);
+  }
+
+  /** sorts small and medium segments of [first, last) */
+  static void sort_run(T* data, const std::size_t* offsets, std::size_t first,
+                       std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      std::size_t size = offsets[i + 1] - offsets[i];
+      if (size <= NetworkSort<T>::max_size) {
+        NetworkSort<T>{}(data + offsets[i], size);
+      } else if (size < huge_size) {
+        QuickSort<T>{}(data + offsets[i], size);
+      }
+    }
+  }
+};
+
+}  // namespace sortings
+
+}  // namespace srtbch
+
+#endif  // SORT_BENCH_PARALLEL_SORTINGS_HPP
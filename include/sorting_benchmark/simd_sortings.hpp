@@ -0,0 +1,534 @@
+/** @file
+ *  vectorized sortings for primitive keys with runtime choice of instruction
+ *  set(AVX-512, AVX2 or scalar)
+ */
+
+#ifndef SORT_BENCH_SIMD_SORTINGS_HPP
+#define SORT_BENCH_SIMD_SORTINGS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "sortings.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define SORT_BENCH_SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SORT_BENCH_SIMD_X86 0
+#endif
+
+namespace srtbch {
+
+namespace sortings {
+
+/** instruction sets of SimdSort, ordered from the least to the most capable */
+enum class SimdLevel { scalar, avx2, avx512 };
+
+namespace detail {
+
+/** lane types of vectorized sortings */
+enum class SimdKind { none, i32, u32, f32, i64, f64 };
+
+template <typename T>
+constexpr SimdKind simd_kind() noexcept {
+  if constexpr (std::is_same_v<T, float>) {
+    return SimdKind::f32;
+  } else if constexpr (std::is_same_v<T, double>) {
+    return SimdKind::f64;
+  } else if constexpr (!std::is_integral_v<T> || std::is_same_v<T, bool>) {
+    return SimdKind::none;
+  } else if constexpr (sizeof(T) == 4) {
+    return std::is_signed_v<T> ? SimdKind::i32 : SimdKind::u32;
+  } else if constexpr (sizeof(T) == 8 && std::is_signed_v<T>) {
+    return SimdKind::i64;
+  } else {
+    return SimdKind::none;
+  }
+}
+
+/** value, that goes after every key, pads small arrays to vector sizes */
+template <typename T>
+constexpr T simd_padding() noexcept {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::numeric_limits<T>::infinity();
+  } else {
+    return std::numeric_limits<T>::max();
+  }
+}
+
+/** permutations of 8 32-bit lanes, that move lanes with set bits of mask to
+ *  the front and the others to the back, both in order, Lanes = 4 is for
+ *  64-bit lanes(every one is a pair of 32-bit lanes)
+ */
+template <std::size_t Lanes>
+struct CompressTable {
+  int lanes[std::size_t{1} << Lanes][8];
+
+  constexpr CompressTable() : lanes{} {
+    constexpr std::size_t width = 8 / Lanes;
+    for (std::size_t mask = 0; mask < (std::size_t{1} << Lanes); ++mask) {
+      std::size_t k = 0;
+      for (int set = 1; set >= 0; --set) {
+        for (std::size_t l = 0; l < Lanes; ++l) {
+          if (((mask >> l) & 1) != static_cast<std::size_t>(set)) continue;
+          for (std::size_t w = 0; w < width; ++w) {
+            lanes[mask][k++] = static_cast<int>(l * width + w);
+          }
+        }
+      }
+    }
+  }
+};
+
+inline constexpr CompressTable<8> compress_32{};
+inline constexpr CompressTable<4> compress_64{};
+
+/** SimdLevel supported by processor(and OS) */
+inline SimdLevel simd_support() noexcept {
+#if SORT_BENCH_SIMD_X86
+  __builtin_cpu_init();
+  if (!__builtin_cpu_supports("popcnt")) return SimdLevel::scalar;
+  if (__builtin_cpu_supports("avx512f")) return SimdLevel::avx512;
+  if (__builtin_cpu_supports("avx2")) return SimdLevel::avx2;
+#endif
+  return SimdLevel::scalar;
+}
+
+}  // namespace detail
+
+#if SORT_BENCH_SIMD_X86
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,popcnt"))), \
+                             apply_to = function)
+#else
+#pragma GCC push_options
+#pragma GCC target("avx2,popcnt")
+#endif
+
+/** AVX2 vectors, 256 bit */
+namespace avx2 {
+
+using detail::SimdKind;
+
+template <typename T, SimdKind = detail::simd_kind<T>()>
+struct Vec;
+
+/** common part of vectors of 32-bit lanes in __m256i */
+struct Int32Vec {
+  using reg = __m256i;
+  using index = __m256i;
+  using select = __m256i;
+  static constexpr std::size_t lanes = 8;
+
+  static index make_index(const int* lanes) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes));
+  }
+  static select make_select(unsigned bits) noexcept {
+    alignas(32) int mask[8];
+    for (int l = 0; l < 8; ++l) mask[l] = (bits >> l) & 1 ? -1 : 0;
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(mask));
+  }
+  static reg permute(reg v, index idx) noexcept {
+    return _mm256_permutevar8x32_epi32(v, idx);
+  }
+  static reg blend(reg a, reg b, select sel) noexcept {
+    return _mm256_blendv_epi8(a, b, sel);
+  }
+  static index compress(unsigned mask) noexcept {
+    return make_index(detail::compress_32.lanes[mask]);
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::i32> : Int32Vec {
+  static reg load(const T* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static void store(T* p, reg v) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+  static reg set(T x) noexcept { return _mm256_set1_epi32(x); }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_epi32(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_epi32(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    return static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(b, a))));
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::u32> : Int32Vec {
+  static reg load(const T* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static void store(T* p, reg v) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+  static reg set(T x) noexcept {
+    return _mm256_set1_epi32(static_cast<int>(x));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_epu32(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_epu32(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    // no unsigned comparison, flipped sign bits keep the order for signed
+    const reg sign = _mm256_set1_epi32(std::numeric_limits<int>::min());
+    reg gt = _mm256_cmpgt_epi32(_mm256_xor_si256(b, sign),
+                                _mm256_xor_si256(a, sign));
+    return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(gt)));
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::f32> : Int32Vec {
+  using reg = __m256;
+
+  static reg load(const T* p) noexcept { return _mm256_loadu_ps(p); }
+  static void store(T* p, reg v) noexcept { _mm256_storeu_ps(p, v); }
+  static reg set(T x) noexcept { return _mm256_set1_ps(x); }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_ps(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_ps(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    return static_cast<unsigned>(
+        _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LT_OQ)));
+  }
+  static reg permute(reg v, index idx) noexcept {
+    return _mm256_permutevar8x32_ps(v, idx);
+  }
+  static reg blend(reg a, reg b, select sel) noexcept {
+    return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(sel));
+  }
+};
+
+/** common part of vectors of 64-bit lanes, lane l is pair of 32-bit lanes
+ *  (2 * l, 2 * l + 1) for permutations
+ */
+struct Int64Vec {
+  using reg = __m256i;
+  using index = __m256i;
+  using select = __m256i;
+  static constexpr std::size_t lanes = 4;
+
+  static index make_index(const int* lanes) noexcept {
+    alignas(32) int pairs[8];
+    for (int l = 0; l < 4; ++l) {
+      pairs[2 * l] = 2 * lanes[l];
+      pairs[2 * l + 1] = 2 * lanes[l] + 1;
+    }
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(pairs));
+  }
+  static select make_select(unsigned bits) noexcept {
+    alignas(32) std::int64_t mask[4];
+    for (int l = 0; l < 4; ++l) mask[l] = (bits >> l) & 1 ? -1 : 0;
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(mask));
+  }
+  static reg permute(reg v, index idx) noexcept {
+    return _mm256_permutevar8x32_epi32(v, idx);
+  }
+  static reg blend(reg a, reg b, select sel) noexcept {
+    return _mm256_blendv_epi8(a, b, sel);
+  }
+  static index compress(unsigned mask) noexcept {
+    return _mm256_loadu_si256(
+        reinterpret_cast<const __m256i*>(detail::compress_64.lanes[mask]));
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::i64> : Int64Vec {
+  static reg load(const T* p) noexcept {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static void store(T* p, reg v) noexcept {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), v);
+  }
+  static reg set(T x) noexcept {
+    return _mm256_set1_epi64x(static_cast<long long>(x));
+  }
+  // no 64-bit min and max before AVX-512
+  static reg min(reg a, reg b) noexcept {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+  }
+  static reg max(reg a, reg b) noexcept {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+  }
+  static unsigned less(reg a, reg b) noexcept {
+    return static_cast<unsigned>(
+        _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(b, a))));
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::f64> : Int64Vec {
+  using reg = __m256d;
+
+  static reg load(const T* p) noexcept { return _mm256_loadu_pd(p); }
+  static void store(T* p, reg v) noexcept { _mm256_storeu_pd(p, v); }
+  static reg set(T x) noexcept { return _mm256_set1_pd(x); }
+  static reg min(reg a, reg b) noexcept { return _mm256_min_pd(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm256_max_pd(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    return static_cast<unsigned>(
+        _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LT_OQ)));
+  }
+  static reg permute(reg v, index idx) noexcept {
+    return _mm256_castps_pd(
+        _mm256_permutevar8x32_ps(_mm256_castpd_ps(v), idx));
+  }
+  static reg blend(reg a, reg b, select sel) noexcept {
+    return _mm256_blendv_pd(a, b, _mm256_castsi256_pd(sel));
+  }
+};
+
+/** stores lanes of v with set bits of mask to [left, left + count), the
+ *  others to [right - (lanes - count), right), writes whole vectors at left
+ *  and right - lanes, returns count
+ */
+template <typename T>
+std::size_t store_partitioned(T* left, T* right, typename Vec<T>::reg v,
+                              unsigned mask) noexcept {
+  using V = Vec<T>;
+  typename V::reg packed = V::permute(v, V::compress(mask));
+  V::store(left, packed);
+  V::store(right - V::lanes, packed);
+  return static_cast<std::size_t>(__builtin_popcount(mask));
+}
+
+#include "simd_sortings_impl.hpp"
+
+}  // namespace avx2
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#pragma clang attribute push(__attribute__((target("avx512f,popcnt"))), \
+                             apply_to = function)
+#else
+#pragma GCC pop_options
+#pragma GCC push_options
+#pragma GCC target("avx512f,popcnt")
+// _mm512_undefined_* in intrinsics are reported as uninitialized by GCC 12
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+/** AVX-512 vectors, 512 bit, only AVX512F instructions are used */
+namespace avx512 {
+
+using detail::SimdKind;
+
+template <typename T, SimdKind = detail::simd_kind<T>()>
+struct Vec;
+
+struct Int32Vec {
+  using reg = __m512i;
+  using index = __m512i;
+  using select = __mmask16;
+  static constexpr std::size_t lanes = 16;
+
+  static index make_index(const int* lanes) noexcept {
+    return _mm512_loadu_si512(lanes);
+  }
+  static select make_select(unsigned bits) noexcept {
+    return static_cast<__mmask16>(bits);
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::i32> : Int32Vec {
+  static reg load(const T* p) noexcept { return _mm512_loadu_si512(p); }
+  static void store(T* p, reg v) noexcept { _mm512_storeu_si512(p, v); }
+  static reg set(T x) noexcept { return _mm512_set1_epi32(x); }
+  static reg min(reg a, reg b) noexcept { return _mm512_min_epi32(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm512_max_epi32(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    return _mm512_cmplt_epi32_mask(a, b);
+  }
+  static reg permute(reg v, index idx) noexcept {
+    return _mm512_permutexvar_epi32(idx, v);
+  }
+  static reg blend(reg a, reg b, select sel) noexcept {
+    return _mm512_mask_blend_epi32(sel, a, b);
+  }
+  static void compress(T* p, unsigned mask, reg v) noexcept {
+    _mm512_mask_compressstoreu_epi32(p, static_cast<__mmask16>(mask), v);
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::u32> : Vec<std::int32_t, SimdKind::i32> {
+  static reg load(const T* p) noexcept { return _mm512_loadu_si512(p); }
+  static void store(T* p, reg v) noexcept { _mm512_storeu_si512(p, v); }
+  static reg set(T x) noexcept {
+    return _mm512_set1_epi32(static_cast<int>(x));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm512_min_epu32(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm512_max_epu32(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    return _mm512_cmplt_epu32_mask(a, b);
+  }
+  static void compress(T* p, unsigned mask, reg v) noexcept {
+    _mm512_mask_compressstoreu_epi32(p, static_cast<__mmask16>(mask), v);
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::f32> : Int32Vec {
+  using reg = __m512;
+
+  static reg load(const T* p) noexcept { return _mm512_loadu_ps(p); }
+  static void store(T* p, reg v) noexcept { _mm512_storeu_ps(p, v); }
+  static reg set(T x) noexcept { return _mm512_set1_ps(x); }
+  static reg min(reg a, reg b) noexcept { return _mm512_min_ps(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm512_max_ps(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+  }
+  static reg permute(reg v, index idx) noexcept {
+    return _mm512_permutexvar_ps(idx, v);
+  }
+  static reg blend(reg a, reg b, select sel) noexcept {
+    return _mm512_mask_blend_ps(sel, a, b);
+  }
+  static void compress(T* p, unsigned mask, reg v) noexcept {
+    _mm512_mask_compressstoreu_ps(p, static_cast<__mmask16>(mask), v);
+  }
+};
+
+struct Int64Vec {
+  using reg = __m512i;
+  using index = __m512i;
+  using select = __mmask8;
+  static constexpr std::size_t lanes = 8;
+
+  static index make_index(const int* lanes) noexcept {
+    alignas(64) long long wide[8];
+    for (int l = 0; l < 8; ++l) wide[l] = lanes[l];
+    return _mm512_load_si512(wide);
+  }
+  static select make_select(unsigned bits) noexcept {
+    return static_cast<__mmask8>(bits);
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::i64> : Int64Vec {
+  static reg load(const T* p) noexcept { return _mm512_loadu_si512(p); }
+  static void store(T* p, reg v) noexcept { _mm512_storeu_si512(p, v); }
+  static reg set(T x) noexcept {
+    return _mm512_set1_epi64(static_cast<long long>(x));
+  }
+  static reg min(reg a, reg b) noexcept { return _mm512_min_epi64(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm512_max_epi64(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    return _mm512_cmplt_epi64_mask(a, b);
+  }
+  static reg permute(reg v, index idx) noexcept {
+    return _mm512_permutexvar_epi64(idx, v);
+  }
+  static reg blend(reg a, reg b, select sel) noexcept {
+    return _mm512_mask_blend_epi64(sel, a, b);
+  }
+  static void compress(T* p, unsigned mask, reg v) noexcept {
+    _mm512_mask_compressstoreu_epi64(p, static_cast<__mmask8>(mask), v);
+  }
+};
+
+template <typename T>
+struct Vec<T, SimdKind::f64> : Int64Vec {
+  using reg = __m512d;
+
+  static reg load(const T* p) noexcept { return _mm512_loadu_pd(p); }
+  static void store(T* p, reg v) noexcept { _mm512_storeu_pd(p, v); }
+  static reg set(T x) noexcept { return _mm512_set1_pd(x); }
+  static reg min(reg a, reg b) noexcept { return _mm512_min_pd(a, b); }
+  static reg max(reg a, reg b) noexcept { return _mm512_max_pd(a, b); }
+  static unsigned less(reg a, reg b) noexcept {
+    return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+  }
+  static reg permute(reg v, index idx) noexcept {
+    return _mm512_permutexvar_pd(idx, v);
+  }
+  static reg blend(reg a, reg b, select sel) noexcept {
+    return _mm512_mask_blend_pd(sel, a, b);
+  }
+  static void compress(T* p, unsigned mask, reg v) noexcept {
+    _mm512_mask_compressstoreu_pd(p, static_cast<__mmask8>(mask), v);
+  }
+};
+
+/** stores lanes of v with set bits of mask to [left, left + count), the
+ *  others to [right - (lanes - count), right), returns count
+ */
+template <typename T>
+std::size_t store_partitioned(T* left, T* right, typename Vec<T>::reg v,
+                              unsigned mask) noexcept {
+  using V = Vec<T>;
+  constexpr unsigned all = (1u << V::lanes) - 1;
+  std::size_t count = static_cast<std::size_t>(__builtin_popcount(mask));
+  V::compress(left, mask, v);
+  V::compress(right - (V::lanes - count), ~mask & all, v);
+  return count;
+}
+
+#include "simd_sortings_impl.hpp"
+
+}  // namespace avx512
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#else
+#pragma GCC diagnostic pop
+#pragma GCC pop_options
+#endif
+
+#endif  // SORT_BENCH_SIMD_X86
+
+/** vectorized quicksort for int32_t, uint32_t, float, int64_t and double
+ *  keys(other types, ArrayElement too, are sorted with scalar PdqSort):
+ *  partitioning by vector comparisons and compress stores, partitions up
+ *  to 16 vectors are sorted by bitonic network in registers, instruction set
+ *  is chosen at runtime(AVX-512, AVX2 or scalar), NaN keys are not supported
+ */
+template <typename T>
+struct SimdSort {
+  SimdSort() : SimdSort(SimdLevel::avx512) {}
+
+  /** uses the best supported instruction set, that is not above max_level */
+  explicit SimdSort(SimdLevel max_level)
+      : level_{detail::simd_kind<T>() == detail::SimdKind::none
+                   ? SimdLevel::scalar
+                   : std::min(max_level, supported_level())} {}
+
+  void operator()(T* data, std::size_t size) const {
+#if SORT_BENCH_SIMD_X86
+    if constexpr (detail::simd_kind<T>() != detail::SimdKind::none) {
+      if (level_ == SimdLevel::avx512) return avx512::sort(data, size);
+      if (level_ == SimdLevel::avx2) return avx2::sort(data, size);
+    }
+#endif
+    PdqSort<T>{}(data, size);
+  }
+
+  /** instruction set used by this sorting */
+  SimdLevel level() const noexcept { return level_; }
+
+  /** the best instruction set, supported by processor, detected once */
+  static SimdLevel supported_level() noexcept {
+    static const SimdLevel level = detail::simd_support();
+    return level;
+  }
+
+ private:
+  SimdLevel level_;
+};
+
+}  // namespace sortings
+
+}  // namespace srtbch
+
+#endif  // SORT_BENCH_SIMD_SORTINGS_HPP
@@ -0,0 +1,207 @@
+/** @file
+ *  vectorized quicksort on top of Vec<T> and store_partitioned() of
+ *  instruction set, this file is included by simd_sortings.hpp inside
+ *  namespace of every instruction set, with its target options on, so it has
+ *  no include guard and must not be included anywhere else
+ */
+
+/** partitions up to network_vectors vectors are sorted by bitonic network */
+inline constexpr std::size_t network_vectors = 16;
+
+/** compare-exchange of lanes of a and b, partner of every lane is the
+ *  second operand of min and max, so of equal floating point zeros each one
+ *  is kept
+ */
+template <typename V>
+inline void exchange(typename V::reg& a, typename V::reg& b) noexcept {
+  typename V::reg lo = V::min(a, b);
+  b = V::max(b, a);
+  a = lo;
+}
+
+/** compare-exchange of lanes of every vector with lanes(l ^ partner_xor),
+ *  lanes with bit high set get larger values
+ */
+template <typename V>
+inline void exchange_lanes(typename V::reg* v, std::size_t vectors,
+                           std::size_t partner_xor, std::size_t high) noexcept {
+  int lanes[V::lanes];
+  unsigned bits = 0;
+  for (std::size_t l = 0; l < V::lanes; ++l) {
+    lanes[l] = static_cast<int>(l ^ partner_xor);
+    if (l & high) bits |= 1u << l;
+  }
+  typename V::index idx = V::make_index(lanes);
+  typename V::select sel = V::make_select(bits);
+
+  for (std::size_t i = 0; i < vectors; ++i) {
+    typename V::reg partner = V::permute(v[i], idx);
+    v[i] = V::blend(V::min(v[i], partner), V::max(v[i], partner), sel);
+  }
+}
+
+/** bitonic sort of buf[0, size), size is power of two and multiple of lanes
+ *  up to network_vectors vectors, every merge starts with comparison of
+ *  mirrored elements, so all of them go up and no directions are needed
+ */
+template <typename T>
+void network_sort(T* buf, std::size_t size) noexcept {
+  using V = Vec<T>;
+  constexpr std::size_t lanes = V::lanes;
+  std::size_t vectors = size / lanes;
+
+  typename V::reg v[network_vectors];
+  for (std::size_t i = 0; i < vectors; ++i) v[i] = V::load(buf + i * lanes);
+
+  int reversed[lanes];
+  for (std::size_t l = 0; l < lanes; ++l) {
+    reversed[l] = static_cast<int>(lanes - 1 - l);
+  }
+  typename V::index reverse = V::make_index(reversed);
+
+  for (std::size_t block = 2; block <= size; block *= 2) {
+    if (block <= lanes) {
+      exchange_lanes<V>(v, vectors, block - 1, block / 2);
+    } else {
+      std::size_t block_vectors = block / lanes;
+      for (std::size_t b = 0; b < vectors; b += block_vectors) {
+        for (std::size_t j = 0; j < block_vectors / 2; ++j) {
+          typename V::reg& lo = v[b + j];
+          typename V::reg& hi = v[b + block_vectors - 1 - j];
+          hi = V::permute(hi, reverse);
+          exchange<V>(lo, hi);
+          hi = V::permute(hi, reverse);
+        }
+      }
+    }
+
+    for (std::size_t step = block / 4; step > 0; step /= 2) {
+      if (step < lanes) {
+        exchange_lanes<V>(v, vectors, step, step);
+        continue;
+      }
+
+      std::size_t step_vectors = step / lanes;
+      for (std::size_t i = 0; i < vectors; ++i) {
+        if ((i & step_vectors) == 0) exchange<V>(v[i], v[i + step_vectors]);
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < vectors; ++i) V::store(buf + i * lanes, v[i]);
+}
+
+/** sorts up to network_vectors vectors of elements, they are padded to power
+ *  of two with the greatest value
+ */
+template <typename T>
+void small_sort(T* data, std::size_t size) noexcept {
+  constexpr std::size_t lanes = Vec<T>::lanes;
+  if (size < 2) return;
+
+  std::size_t padded = lanes;
+  while (padded < size) padded *= 2;
+
+  alignas(64) T buf[network_vectors * lanes];
+  std::copy(data, data + size, buf);
+  std::fill(buf + size, buf + padded, detail::simd_padding<T>());
+  network_sort(buf, padded);
+  std::copy(buf, buf + size, data);
+}
+
+/** partitions data by pivot, elements less than pivot(not greater if
+ *  OrEqual) go first, returns their amount, size is at least 2 vectors: the
+ *  first and the last vectors are kept in registers, so there is always room
+ *  for whole vector stores at both write positions
+ */
+template <typename T, bool OrEqual>
+std::size_t partition(T* data, std::size_t size, T pivot) noexcept {
+  using V = Vec<T>;
+  constexpr std::size_t lanes = V::lanes;
+  constexpr unsigned all = (1u << lanes) - 1;
+
+  typename V::reg p = V::set(pivot);
+  auto goes_left = [p](typename V::reg v) {
+    return OrEqual ? ~V::less(p, v) & all : V::less(v, p);
+  };
+
+  typename V::reg first = V::load(data);
+  typename V::reg last = V::load(data + size - lanes);
+
+  // written [0, left) and [right, size), not read [read_left, read_right)
+  std::size_t left = 0, right = size;
+  std::size_t read_left = lanes, read_right = size - lanes;
+
+  // tail, that is not whole vector, goes one by one
+  for (std::size_t rest = (read_right - read_left) % lanes; rest > 0; --rest) {
+    T elem = data[read_left++];
+    if (OrEqual ? !(pivot < elem) : elem < pivot) {
+      data[left++] = elem;
+    } else {
+      data[--right] = elem;
+    }
+  }
+
+  while (read_left != read_right) {
+    // side with less room is read, so both have room for a vector after
+    typename V::reg v;
+    if (read_left - left <= right - read_right) {
+      v = V::load(data + read_left);
+      read_left += lanes;
+    } else {
+      read_right -= lanes;
+      v = V::load(data + read_right);
+    }
+
+    std::size_t count = store_partitioned(data + left, data + right, v,
+                                          goes_left(v));
+    left += count;
+    right -= lanes - count;
+  }
+
+  std::size_t count = store_partitioned(data + left, data + right, first,
+                                        goes_left(first));
+  left += count;
+  right -= lanes - count;
+  left += store_partitioned(data + left, data + right, last, goes_left(last));
+
+  return left;
+}
+
+/** introsort loop: smaller part is sorted recursively, larger one in place,
+ *  HeapSort after depth partitions
+ */
+template <typename T>
+void quick_sort(T* data, std::size_t size, std::size_t depth) {
+  constexpr std::size_t network_size = network_vectors * Vec<T>::lanes;
+
+  while (size > network_size) {
+    if (depth-- == 0) return HeapSort<T>{}(data, size);
+
+    T pivot = data[QuickSort<T>::select_pivot(data, 0, size - 1)];
+    std::size_t less = partition<T, false>(data, size, pivot);
+    if (less == 0) {
+      // pivot is the least, elements equal to it are in place
+      std::size_t not_greater = partition<T, true>(data, size, pivot);
+      data += not_greater;
+      size -= not_greater;
+      continue;
+    }
+
+    if (less < size - less) {
+      quick_sort(data, less, depth);
+      data += less;
+      size -= less;
+    } else {
+      quick_sort(data + less, size - less, depth);
+      size = less;
+    }
+  }
+
+  small_sort(data, size);
+}
+
+template <typename T>
+void sort(T* data, std::size_t size) {
+  quick_sort(data, size, 2 * detail::log2(size));
+}
@@ -9,8 +9,10 @@
 #include <array>
 #include <chrono>
 #include <functional>
+#include <random>
 #include <stdexcept>
 #include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include "array_element.hpp"
@@ -52,11 +54,21 @@ class SortBench {
 
   bool is_inited{false};
 
+  bool large{false};
+
+  std::size_t min_segment{0};
+  std::size_t max_segment{0};
+  std::mt19937 segment_gen{};
+  std::vector<std::size_t> offsets;
+  std::vector<double> seg_per_sec;
+
  public:
   SortBench(bool keep_before = false, bool keep_after = false);
 
   void keep_before(bool should = true);
   void keep_after(bool should = true);
+  void large_mode(bool should = true);
+  void batch_mode(std::size_t min_size, std::size_t max_size);
 
   SortStats operator()(const std::vector<std::size_t>& array_sizes);
   SortStats operator()(std::size_t array_size, std::size_t measure_num);
@@ -64,9 +76,19 @@ class SortBench {
   std::vector<std::vector<T>> notsorted_arrays();
   std::vector<std::vector<T>> sorted_arrays();
 
+  const SortFunctor<T>& sort_functor() const noexcept;
+
+  const std::vector<std::size_t>& segment_offsets() const noexcept;
+  const std::vector<double>& segments_per_second() const noexcept;
+
  private:
   void clear_data();
 
+  void split_segments(std::size_t size);
+  template <typename U>
+  void sort_segments(SortFunctor<U>& sort, std::vector<U>& vec);
+  bool segments_sorted(const std::vector<T>& vec) const;
+
   void measure(std::size_t sz);
 
   std::pair<std::size_t, std::size_t> test_single_cmp_asgn(
@@ -96,6 +118,38 @@ void SortBench<T, SortFunctor, GenFunc>::keep_after(
   keep_aft = should;
 }
 
+/** mode for huge arrays(above 2^31 elements): only time is measured,
+ *  comparisons and assignments are not counted(it would double memory usage)
+ *  and every sorted array is checked, std::logic_error is thrown if it is not
+ *  sorted
+ */
+template <typename T, template <typename> typename SortFunctor,
+          typename GenFunc>
+void SortBench<T, SortFunctor, GenFunc>::large_mode(
+    bool should)  // false - default
+{
+  large = should;
+}
+
+/** mode for many small independent sorts: every array is split into
+ *  segments of random sizes from [min_size, max_size](the last one may be
+ *  shorter), that are sorted separately, with one call of
+ *  operator()(T* data, const std::size_t* offsets, std::size_t segments) of
+ *  SortFunctor if it has one(segment i is data[offsets[i], offsets[i + 1])),
+ *  one call per segment otherwise; max_size 0 turns the mode off
+ */
+template <typename T, template <typename> typename SortFunctor,
+          typename GenFunc>
+void SortBench<T, SortFunctor, GenFunc>::batch_mode(std::size_t min_size,
+                                                    std::size_t max_size) {
+  if (max_size != 0 && (min_size == 0 || min_size > max_size)) {
+    throw std::invalid_argument{"Segment sizes should be in [1, max_size]"};
+  }
+
+  min_segment = min_size;
+  max_segment = max_size;
+}
+
 template <typename T, template <typename> typename SortFunctor,
           typename GenFunc>
 SortStats SortBench<T, SortFunctor, GenFunc>::operator()(
@@ -154,6 +208,34 @@ SortBench<T, SortFunctor, GenFunc>::sorted_arrays() {
   return sorted_arrs;
 }
 
+/** functor, that sorts arrays of bare T in time measurements(for example to
+ *  read phase durations of ParallelSampleSort)
+ */
+template <typename T, template <typename> typename SortFunctor,
+          typename GenFunc>
+const SortFunctor<T>& SortBench<T, SortFunctor, GenFunc>::sort_functor()
+    const noexcept {
+  return time_sort;
+}
+
+/** offsets of segments of the last measured array in batch mode, the last
+ *  one is its size
+ */
+template <typename T, template <typename> typename SortFunctor,
+          typename GenFunc>
+const std::vector<std::size_t>&
+SortBench<T, SortFunctor, GenFunc>::segment_offsets() const noexcept {
+  return offsets;
+}
+
+/** sorted segments per second in batch mode, one entry per measurement */
+template <typename T, template <typename> typename SortFunctor,
+          typename GenFunc>
+const std::vector<double>&
+SortBench<T, SortFunctor, GenFunc>::segments_per_second() const noexcept {
+  return seg_per_sec;
+}
+
 /** clear previous data */
 template <typename T, template <typename> typename SortFunctor,
           typename GenFunc>
@@ -161,6 +243,52 @@ void SortBench<T, SortFunctor, GenFunc>::clear_data() {
   stats.clear();
   sorted_arrs.clear();
   notsorted_arrs.clear();
+  seg_per_sec.clear();
+  offsets.clear();
+}
+
+/** fills offsets with segments of array of size elements */
+template <typename T, template <typename> typename SortFunctor,
+          typename GenFunc>
+void SortBench<T, SortFunctor, GenFunc>::split_segments(std::size_t size) {
+  std::uniform_int_distribution<std::size_t> seg_size{min_segment,
+                                                      max_segment};
+  offsets.assign(1, 0);
+  while (offsets.back() < size) {
+    offsets.push_back(std::min(size, offsets.back() + seg_size(segment_gen)));
+  }
+}
+
+/** sorts vec as one array, or its segments in batch mode */
+template <typename T, template <typename> typename SortFunctor,
+          typename GenFunc>
+template <typename U>
+void SortBench<T, SortFunctor, GenFunc>::sort_segments(SortFunctor<U>& sort,
+                                                       std::vector<U>& vec) {
+  if (max_segment == 0) return sort(vec.data(), vec.size());
+
+  std::size_t segments = offsets.size() - 1;
+  if constexpr (std::is_invocable_v<SortFunctor<U>&, U*, const std::size_t*,
+                                    std::size_t>) {
+    sort(vec.data(), offsets.data(), segments);
+  } else {
+    for (std::size_t i = 0; i < segments; ++i) {
+      sort(vec.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  }
+}
+
+template <typename T, template <typename> typename SortFunctor,
+          typename GenFunc>
+bool SortBench<T, SortFunctor, GenFunc>::segments_sorted(
+    const std::vector<T>& vec) const {
+  if (max_segment == 0) return std::is_sorted(std::begin(vec), std::end(vec));
+
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    if (!std::is_sorted(vec.begin() + offsets[i], vec.begin() + offsets[i + 1]))
+      return false;
+  }
+  return true;
 }
 
 /** do time and (comparsons and assignments) testings*/
@@ -175,11 +303,20 @@ void SortBench<T, SortFunctor, GenFunc>::measure(std::size_t size) {
     is_inited = true;                // it is inited now
   }
 
-  {  // scope start
+  if (max_segment != 0) split_segments(size);
+
+  if (large) {
+    auto tm{test_single_time(tvec)};
+
+    if (!segments_sorted(tvec)) {
+      throw std::logic_error{"Array is not sorted by SortFunctor"};
+    }
 
-    std::vector<ArrayElement<T>> cavec(size);  // cmp asgn vector
-    std::transform(std::begin(tvec), std::end(tvec), std::begin(cavec),
-                   [](T elem) { return ArrayElement<T>{elem}; });
+    stats.push_back({size, tm, {0, 0}});
+  } else {
+    // cmp asgn vector, constructed from tvec, so nothing is counted before
+    // sorting
+    std::vector<ArrayElement<T>> cavec(std::begin(tvec), std::end(tvec));
 
     auto tm{test_single_time(tvec)};
     // time test with "bare"(of type T) elements
@@ -191,7 +328,14 @@ void SortBench<T, SortFunctor, GenFunc>::measure(std::size_t size) {
     stats.push_back({size, tm, {cmp, asgn}});
     // add measurements
 
-  }  // scope end for minimize usage of memory(lifetime of cavec ends here)
+  }  // lifetime of cavec ends here, to minimize usage of memory
+
+  if (max_segment != 0) {
+    std::chrono::duration<double> tm{std::max(
+        std::get<std::chrono::nanoseconds>(stats.back()),
+        std::chrono::nanoseconds{1})};
+    seg_per_sec.push_back((offsets.size() - 1) / tm.count());
+  }
 
   if (keep_aft) {
     sorted_arrs.push_back(tvec);  // add sorted array to sort_arrays
@@ -204,7 +348,7 @@ template <typename T, template <typename> typename SortFunctor,
 std::pair<std::size_t, std::size_t>
 SortBench<T, SortFunctor, GenFunc>::test_single_cmp_asgn(
     std::vector<ArrayElement<T>>& vec) {
-  cmp_asgn_sort(vec.data(), vec.size());
+  sort_segments(cmp_asgn_sort, vec);
 
   auto cmp = ArrayElement<T>::get_cmp();
   auto asgn = ArrayElement<T>::get_asgn();
@@ -221,7 +365,7 @@ std::chrono::nanoseconds SortBench<T, SortFunctor, GenFunc>::test_single_time(
   using namespace std::chrono;
 
   steady_clock::time_point start{steady_clock::now()};
-  time_sort(vec.data(), vec.size());
+  sort_segments(time_sort, vec);
   steady_clock::time_point end{steady_clock::now()};
 
   return nanoseconds(end - start);
@@ -1,16 +1,90 @@
 #ifndef SORTING_BENCH_SORTINGS_HPP
 #define SORTING_BENCH_SORTINGS_HPP
 
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <type_traits>
 #include <utility>
+#include <vector>
+
+#include "array_element.hpp"
 
 namespace srtbch {
 
 namespace sortings {
 
+namespace detail {
+
+/** key extraction for sortings, that work with values directly(not only
+ *  through comparisons), unwraps ArrayElement<T> to T
+ */
+template <typename T>
+struct Key {
+  using type = T;
+  static const T& of(const T& elem) noexcept { return elem; }
+};
+
+template <typename T>
+struct Key<ArrayElement<T>> {
+  using type = T;
+  static const T& of(const ArrayElement<T>& elem) noexcept {
+    return elem.value();
+  }
+};
+
+/** keys of radix sortings: integral key mapped to unsigned one with the same
+ *  order(sign bit flipped), split to byte digits
+ */
+template <typename T>
+struct RadixKey {
+  using K = typename Key<T>::type;
+  using U = std::make_unsigned_t<K>;
+
+  static constexpr std::size_t bits = CHAR_BIT;
+  static constexpr std::size_t radix = std::size_t{1} << bits;
+  static constexpr std::size_t passes = sizeof(K);
+
+  static U of(const T& elem) noexcept {
+    U key = static_cast<U>(Key<T>::of(elem));
+    if constexpr (std::is_signed_v<K>) {
+      key ^= static_cast<U>(U{1} << (sizeof(K) * CHAR_BIT - 1));
+    }
+    return key;
+  }
+
+  static std::size_t digit(U key, std::size_t pass) noexcept {
+    return static_cast<std::size_t>(key >> (pass * bits)) & (radix - 1);
+  }
+};
+
+/** floor of binary logarithm, 0 for 0 */
+inline std::size_t log2(std::size_t n) noexcept {
+  std::size_t res = 0;
+  while (n >>= 1) ++res;
+  return res;
+}
+
+/** hint to fetch cache line with addr, noop when compiler has no builtin */
+inline void prefetch(const void* addr) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(addr);
+#else
+  (void)addr;
+#endif
+}
+
+}  // namespace detail
+
 template <typename T>
 struct SelectionSort {
   void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
     std::size_t i, j, min_idx;
 
     for (i = 0; i < size - 1; i++) {
@@ -26,6 +100,7 @@ struct SelectionSort {
 template <typename T>
 struct BubbleSort {
   void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
     std::size_t i, j;
     for (i = 0; i < size - 1; i++)
       for (j = 0; j < size - i - 1; j++)
@@ -36,115 +111,505 @@ struct BubbleSort {
 template <typename T>
 struct InsertionSort {
   void operator()(T* data, std::size_t size) const {
-    int i, j, isize = size;
-    T* key;
-
-    for (i = 1; i < isize; i++) {
-      key = &data[i];
-      j = i - 1;
+    for (std::size_t i = 1; i < size; i++) {
+      T key = std::move(data[i]);
+      std::size_t j = i;
 
-      while (j >= 0 && data[j] > *key) {
-        data[j + 1] = data[j];
+      while (j > 0 && data[j - 1] > key) {
+        data[j] = std::move(data[j - 1]);
         j = j - 1;
       }
-      data[j + 1] = *key;
+      data[j] = std::move(key);
+    }
+  }
+};
+
+/** insertion sort, that finds place of every element with binary search and
+ *  shifts the block after it at once(with memmove for trivially copyable T),
+ *  stable and takes O(n log n) comparisons
+ */
+template <typename T>
+struct BinaryInsertionSort {
+  void operator()(T* data, std::size_t size) const {
+    for (std::size_t i = 1; i < size; i++) {
+      if (!(data[i] < data[i - 1])) continue;
+
+      T* pos = upper_bound(data, i - 1, data[i]);
+      T key = std::move(data[i]);
+      shift(pos, data + i);
+      *pos = std::move(key);
+    }
+  }
+
+ private:
+  /** first element of [first, first + len), that is greater than key, halving
+   *  step does not depend on comparison result(compiles to cmov)
+   */
+  static T* upper_bound(T* first, std::size_t len, const T& key) {
+    if (len == 0) return first;
+
+    while (len > 1) {
+      std::size_t half = len / 2;
+      first = key < first[half] ? first : first + half;
+      len -= half;
+    }
+    return key < *first ? first : first + 1;
+  }
+
+  /** moves [first, last) one position right */
+  static void shift(T* first, T* last) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memmove(first + 1, first, (last - first) * sizeof(T));
+    } else {
+      std::move_backward(first, last, last + 1);
+    }
+  }
+};
+
+namespace detail {
+
+/** comparator of sorting network, puts the lesser element to wire a */
+struct Comparator {
+  std::size_t a;
+  std::size_t b;
+};
+
+/** wires start, start + step, ... of network, size of them */
+struct Wires {
+  std::size_t start;
+  std::size_t step;
+  std::size_t size;
+
+  constexpr std::size_t operator[](std::size_t i) const noexcept {
+    return start + step * i;
+  }
+  constexpr Wires evens() const noexcept {
+    return {start, 2 * step, (size + 1) / 2};
+  }
+  constexpr Wires odds() const noexcept {
+    return {start + step, 2 * step, size / 2};
+  }
+};
+
+inline constexpr std::size_t max_network_size = 64;
+inline constexpr std::size_t max_network_comparators = 544;
+
+/** builds sorting network at compile time: Batcher's odd-even merge sort
+ *  (power of two network without wires from size on) or two halves sorted by
+ *  networks and merged by odd-even merge, which of them is smaller
+ */
+struct NetworkBuilder {
+  Comparator comparators[max_network_comparators]{};
+  std::size_t size{0};
+
+  constexpr void add(std::size_t a, std::size_t b) noexcept {
+    comparators[size++] = {a, b};
+  }
+
+  /** odd-even merge of sorted lo and hi(lo goes before hi) */
+  constexpr void merge(Wires lo, Wires hi) noexcept {
+    if (lo.size == 0 || hi.size == 0) return;
+    if (lo.size == 1 && hi.size == 1) return add(lo[0], hi[0]);
+
+    merge(lo.evens(), hi.evens());
+    merge(lo.odds(), hi.odds());
+    for (std::size_t i = 1; i + 1 < lo.size + hi.size; i += 2) {
+      add(i < lo.size ? lo[i] : hi[i - lo.size],
+          i + 1 < lo.size ? lo[i + 1] : hi[i + 1 - lo.size]);
+    }
+  }
+
+  /** Batcher's network for wires [first, first + n) */
+  constexpr void odd_even_sort(std::size_t first, std::size_t n) noexcept {
+    for (std::size_t p = 1; p < n; p *= 2) {
+      for (std::size_t k = p; k > 0; k /= 2) {
+        for (std::size_t j = k % p; j + k < n; j += 2 * k) {
+          for (std::size_t i = 0; i < k && i + j + k < n; ++i) {
+            if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+              add(first + i + j, first + i + j + k);
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /** network for wires [first, first + n), split[n] - size of the first
+   *  half, or 0 for Batcher's network
+   */
+  constexpr void sort(std::size_t first, std::size_t n,
+                      const std::size_t* split) noexcept {
+    if (split[n] == 0) return odd_even_sort(first, n);
+
+    std::size_t half = split[n];
+    sort(first, half, split);
+    sort(first + half, n - half, split);
+    merge({first, 1, half}, {first + half, 1, n - half});
+  }
+};
+
+/** split of every network size, which gives the least comparators */
+struct NetworkSplits {
+  std::size_t split[max_network_size + 1]{};
+
+  constexpr NetworkSplits() {
+    std::size_t best[max_network_size + 1]{};
+    for (std::size_t n = 2; n <= max_network_size; ++n) {
+      NetworkBuilder batcher;
+      batcher.odd_even_sort(0, n);
+      best[n] = batcher.size;
+
+      for (std::size_t half = 1; half < n; ++half) {
+        NetworkBuilder merge;
+        merge.merge({0, 1, half}, {half, 1, n - half});
+        std::size_t size = best[half] + best[n - half] + merge.size;
+        if (size < best[n]) {
+          best[n] = size;
+          split[n] = half;
+        }
+      }
+    }
+  }
+};
+
+inline constexpr NetworkSplits network_splits{};
+
+template <std::size_t N>
+constexpr NetworkBuilder make_network() noexcept {
+  NetworkBuilder network;
+  network.sort(0, N, network_splits.split);
+  return network;
+}
+
+template <std::size_t N>
+inline constexpr NetworkBuilder network = make_network<N>();
+
+/** puts the lesser of a and b to a, with one comparison and without
+ *  branches(conditional moves) for primitive types
+ */
+template <typename T>
+inline void compare_exchange(T& a, T& b) {
+  bool swap = b < a;
+  T lo = swap ? b : a;
+  b = swap ? a : b;
+  a = std::move(lo);
+}
+
+}  // namespace detail
+
+/** sorting network for N elements(N up to 64), generated at compile time
+ *  and unrolled, comparators are branchless compare-exchanges: optimal for
+ *  N up to 8, Batcher's odd-even merge based above
+ */
+template <typename T, std::size_t N>
+struct SortingNetwork {
+  static_assert(N <= detail::max_network_size,
+                "SortingNetwork is generated for up to 64 elements");
+
+  /** amount of comparators */
+  static constexpr std::size_t size = detail::network<N>.size;
+
+  /** sorts data[0, N) */
+  void operator()(T* data) const {
+    apply(data, std::make_index_sequence<size>{});
+  }
+
+ private:
+  template <std::size_t... I>
+  static void apply(T* data, std::index_sequence<I...>) {
+    (detail::compare_exchange(data[detail::network<N>.comparators[I].a],
+                              data[detail::network<N>.comparators[I].b]),
+     ...);
+  }
+};
+
+template <typename T>
+struct QuickSort;
+
+/** sorts up to max_size elements with SortingNetwork of their amount,
+ *  larger arrays with QuickSort
+ */
+template <typename T>
+struct NetworkSort {
+  static constexpr std::size_t max_size = detail::max_network_size;
+
+  void operator()(T* data, std::size_t size) const {
+    if (size > max_size) return QuickSort<T>{}(data, size);
+
+    networks[size](data);
+  }
+
+ private:
+  using Sort = void (*)(T*);
+
+  template <std::size_t N>
+  static void sort(T* data) {
+    if constexpr (N > 1) SortingNetwork<T, N>{}(data);
+  }
+
+  template <std::size_t... N>
+  static constexpr std::array<Sort, sizeof...(N)> make_networks(
+      std::index_sequence<N...>) noexcept {
+    return {&sort<N>...};
+  }
+
+  static constexpr std::array<Sort, max_size + 1> networks =
+      make_networks(std::make_index_sequence<max_size + 1>{});
+};
+
+/** sorts many independent segments of one buffer in one call, segment i is
+ *  data[offsets[i], offsets[i + 1]): every segment goes straight to the
+ *  SortingNetwork of its size, networks cover up to max_size(64) elements,
+ *  longer segments are sorted with QuickSort, segments are sorted one by
+ *  one, start of the next one is prefetched
+ */
+template <typename T>
+struct BatchSort {
+  static constexpr std::size_t max_size = NetworkSort<T>::max_size;
+
+  void operator()(T* data, const std::size_t* offsets,
+                  std::size_t segments) const {
+    for (std::size_t i = 0; i < segments; ++i) {
+      if (i + 1 < segments) detail::prefetch(data + offsets[i + 1]);
+      NetworkSort<T>{}(data + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  }
+
+  /** whole array is one segment */
+  void operator()(T* data, std::size_t size) const {
+    NetworkSort<T>{}(data, size);
+  }
+};
+
+/** gap sequences for ShellSort, below(bound) returns the largest gap, that is
+ *  less than bound(bound should be greater than 1), smallest gap is 1
+ */
+
+/** Ciura's experimentally found gaps, extended with factor 2.25 */
+struct CiuraGaps {
+  static std::size_t below(std::size_t bound) noexcept {
+    constexpr std::size_t gaps[] = {1, 4, 10, 23, 57, 132, 301, 701, 1750};
+
+    std::size_t prev = 1;
+    for (std::size_t gap : gaps) {
+      if (gap >= bound) return prev;
+      prev = gap;
+    }
+    for (std::size_t gap = prev * 9 / 4; gap < bound && gap > prev;
+         gap = gap * 9 / 4)
+      prev = gap;
+    return prev;
+  }
+};
+
+/** Tokuda's gaps, ceil(h_k), where h_k = 2.25 * h_(k - 1) + 1, h_1 = 1 */
+struct TokudaGaps {
+  static std::size_t below(std::size_t bound) noexcept {
+    std::size_t prev = 1;
+    for (double h = 2.25 + 1;; h = 2.25 * h + 1) {
+      auto gap = static_cast<std::size_t>(std::ceil(h));
+      if (gap >= bound || gap <= prev) return prev;
+      prev = gap;
+    }
+  }
+};
+
+/** Sedgewick's gaps, 1 and 4^k + 3 * 2^(k - 1) + 1 */
+struct SedgewickGaps {
+  static std::size_t below(std::size_t bound) noexcept {
+    std::size_t prev = 1;
+    for (std::size_t k = 1; k < sizeof(std::size_t) * CHAR_BIT / 2; ++k) {
+      std::size_t gap = (std::size_t{1} << (2 * k)) +
+                        3 * (std::size_t{1} << (k - 1)) + 1;
+      if (gap >= bound) break;
+      prev = gap;
+    }
+    return prev;
+  }
+};
+
+/** Pratt's 3-smooth gaps, 2^p * 3^q */
+struct PrattGaps {
+  static std::size_t below(std::size_t bound) noexcept {
+    std::size_t best = 1;
+    for (std::size_t pow3 = 1; pow3 < bound; pow3 *= 3) {
+      std::size_t gap = pow3;
+      while (gap <= (bound - 1) / 2) gap *= 2;
+      if (gap > best) best = gap;
+      if (pow3 > (bound - 1) / 3) break;
+    }
+    return best;
+  }
+};
+
+/** shell sort, GapSequence is one of *Gaps policies above, no extra memory and
+ *  no recursion
+ */
+template <typename T, typename GapSequence = CiuraGaps>
+struct ShellSort {
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    for (std::size_t gap = GapSequence::below(size);;
+         gap = GapSequence::below(gap)) {
+      for (std::size_t i = gap; i < size; ++i) {
+        if (!(data[i] < data[i - gap])) continue;
+
+        T key = std::move(data[i]);
+        std::size_t j = i;
+        do {
+          data[j] = std::move(data[j - gap]);
+          j -= gap;
+        } while (j >= gap && key < data[j - gap]);
+        data[j] = std::move(key);
+      }
+
+      if (gap == 1) break;
     }
   }
 };
 
+template <typename T>
+using CiuraShellSort = ShellSort<T, CiuraGaps>;
+
+template <typename T>
+using TokudaShellSort = ShellSort<T, TokudaGaps>;
+
+template <typename T>
+using SedgewickShellSort = ShellSort<T, SedgewickGaps>;
+
+template <typename T>
+using PrattShellSort = ShellSort<T, PrattGaps>;
+
+/** top-down merge sort, all merges share one scratch buffer of (size + 1) / 2
+ *  elements, either provided by caller or owned by functor and reused between
+ *  calls(so the same functor object does not allocate on repeated sorts)
+ */
 template <typename T>
 struct MergeSort {
+  MergeSort() = default;
+  /** use external buffer, if it is smaller than scratch_size(size) for some
+   *  sorted array, functor falls back to its own buffer
+   */
+  MergeSort(T* buffer, std::size_t capacity)
+      : external_{buffer}, external_capacity_{capacity} {}
+
   void operator()(T* data, std::size_t size) const {
-    return merge_sort(data, 0, size - 1);
+    if (size < 2) return;
+
+    return merge_sort(data, scratch(scratch_size(size)), 0, size - 1);
+  }
+
+  /** size of scratch buffer needed to sort array of size elements */
+  static constexpr std::size_t scratch_size(std::size_t size) noexcept {
+    return (size + 1) / 2;
   }
 
  private:
-  void merge(T* data, std::size_t l, std::size_t m, std::size_t r) const {
-    std::size_t i, j, k;
-    std::size_t n1 = m - l + 1;
-    std::size_t n2 = r - m;
+  T* external_{nullptr};
+  std::size_t external_capacity_{0};
+  mutable std::vector<T> own_;
 
-    T* L = new T[n1];
-    T* R = new T[n2];
+  T* scratch(std::size_t size) const {
+    if (external_ != nullptr && external_capacity_ >= size) return external_;
 
-    for (i = 0; i < n1; i++) L[i] = data[l + i];
-    for (j = 0; j < n2; j++) R[j] = data[m + 1 + j];
+    if (own_.size() < size) own_.resize(size);
+    return own_.data();
+  }
+
+  /** merges [l, m] and [m + 1, r], only left half is moved out to buffer */
+  void merge(T* data, T* buffer, std::size_t l, std::size_t m,
+             std::size_t r) const {
+    std::size_t n1 = m - l + 1;
+    std::move(data + l, data + m + 1, buffer);
 
-    i = 0;
-    j = 0;
-    k = l;
-    while (i < n1 && j < n2) {
-      if (L[i] <= R[j]) {
-        data[k] = L[i];
+    std::size_t i = 0, j = m + 1, k = l;
+    while (i < n1 && j <= r) {
+      if (buffer[i] <= data[j]) {
+        data[k] = std::move(buffer[i]);
         i++;
       } else {
-        data[k] = R[j];
+        data[k] = std::move(data[j]);
         j++;
       }
       k++;
     }
 
+    // rest of the right half is already in place
     while (i < n1) {
-      data[k] = L[i];
+      data[k] = std::move(buffer[i]);
       i++;
       k++;
     }
-
-    while (j < n2) {
-      data[k] = R[j];
-      j++;
-      k++;
-    }
-
-    delete[] L;
-    delete[] R;
   }
 
-  void merge_sort(T* data, std::size_t l, std::size_t r) const {
-    if (r - l == 0) return;
-
+  void merge_sort(T* data, T* buffer, std::size_t l, std::size_t r) const {
     if (l < r) {
       std::size_t m = l + (r - l) / 2;
 
-      merge_sort(data, l, m);
-      merge_sort(data, m + 1, r);
+      merge_sort(data, buffer, l, m);
+      merge_sort(data, buffer, m + 1, r);
 
-      merge(data, l, m, r);
+      merge(data, buffer, l, m, r);
     }
   }
 };
 
+/** iterative bottom-up merge sort, starts from insertion sorted runs of
+ *  run_size elements, then merges alternate between array and one scratch
+ *  buffer of size elements(owned by functor and reused between calls)
+ */
 template <typename T>
-struct QuickSort {
+struct BottomUpMergeSort {
+  static constexpr std::size_t run_size = 32;
+
   void operator()(T* data, std::size_t size) const {
-    return quick_sort(data, 0, size - 1);
-  }
+    if (size < 2) return;
 
-  int partition(T* data, int low, int high) const {
-    T& pivot = data[high];
-    int i = (low - 1);
+    for (std::size_t lo = 0; lo < size; lo += run_size)
+      InsertionSort<T>{}(data + lo, std::min(run_size, size - lo));
+    if (size <= run_size) return;
 
-    for (int j = low; j <= high - 1; ++j) {
-      if (data[j] < pivot) {
-        ++i;
-        std::swap(data[i], data[j]);
+    if (buffer_.size() < size) buffer_.resize(size);
+    T* src = data;
+    T* dst = buffer_.data();
+
+    for (std::size_t width = run_size; width < size; width *= 2) {
+      for (std::size_t lo = 0; lo < size; lo += 2 * width) {
+        std::size_t mid = std::min(lo + width, size);
+        std::size_t hi = std::min(lo + 2 * width, size);
+        merge(src, dst, lo, mid, hi);
       }
+      std::swap(src, dst);
     }
-    std::swap(data[i + 1], data[high]);
 
-    return (i + 1);
+    if (src != data) std::move(src, src + size, data);
   }
 
-  void quick_sort(T* data, int low, int high) const {
-    if (low < high) {
-      int pi = partition(data, low, high);
+ private:
+  mutable std::vector<T> buffer_;
 
-      quick_sort(data, low, pi - 1);
-      quick_sort(data, pi + 1, high);
+  /** merges src[lo, mid) and src[mid, hi) to dst[lo, hi) */
+  static void merge(T* src, T* dst, std::size_t lo, std::size_t mid,
+                    std::size_t hi) {
+    std::size_t i = lo, j = mid, k = lo;
+    while (i < mid && j < hi) {
+      if (src[i] <= src[j]) {
+        dst[k++] = std::move(src[i++]);
+      } else {
+        dst[k++] = std::move(src[j++]);
+      }
     }
+
+    std::move(src + i, src + mid, dst + k);
+    std::move(src + j, src + hi, dst + k + (mid - i));
   }
 };
 
+/** heapsort with iterative hole-based sift-down(elements are moved, not
+ *  swapped) and Floyd's bounce: hole goes down to a leaf along larger children
+ *  with one comparison per level, then sifted element goes back up
+ */
 template <typename T>
 struct HeapSort {
   void operator()(T* data, std::size_t size) const {
@@ -152,44 +617,1427 @@ struct HeapSort {
   }
 
  private:
-  void heapify(T* data, std::size_t size, std::size_t i) const {
-    std::size_t largest = i;
-    std::size_t l = 2 * i + 1;
-    std::size_t r = 2 * i + 2;
+  /** places value to the heap rooted at top, which has a hole in top */
+  void sift_down(T* data, std::size_t size, std::size_t top, T value) const {
+    std::size_t hole = top;
+    std::size_t child = 2 * hole + 2;
 
-    if (l < size && data[l] > data[largest]) largest = l;
+    while (child < size) {
+      if (data[child] < data[child - 1]) --child;
+      data[hole] = std::move(data[child]);
+      hole = child;
+      child = 2 * hole + 2;
+    }
+    if (child == size) {
+      data[hole] = std::move(data[size - 1]);
+      hole = size - 1;
+    }
 
-    if (r < size && data[r] > data[largest]) largest = r;
+    while (hole > top) {
+      std::size_t parent = (hole - 1) / 2;
+      if (!(data[parent] < value)) break;
 
-    if (largest != i) {
-      std::swap(data[i], data[largest]);
-      heapify(data, size, largest);
+      data[hole] = std::move(data[parent]);
+      hole = parent;
     }
+    data[hole] = std::move(value);
   }
 
   void heap_sort(T* data, std::size_t size) const {
-    for (int i = size / 2 - 1; i >= 0; --i) heapify(data, size, i);
+    if (size < 2) return;
+
+    for (std::size_t i = size / 2; i-- > 0;)
+      sift_down(data, size, i, std::move(data[i]));
 
-    for (int i = size - 1; i >= 0; --i) {
-      std::swap(data[0], data[i]);
-      heapify(data, i, 0);
+    for (std::size_t i = size - 1; i > 0; --i) {
+      T value = std::move(data[i]);
+      data[i] = std::move(data[0]);
+      sift_down(data, i, 0, std::move(value));
     }
   }
 };
 
-template <typename T>
-struct CountingSort {
-  void operator()(T* data, std::size_t size) const {}
+/** heapsort on D-ary heap, where children of every node share one cache line:
+ *  heap starts from the element, after which child groups are aligned to
+ *  D * sizeof(T) bytes(few elements before it are inserted after sorting),
+ *  grandchildren are prefetched during sift-down
+ */
+template <typename T, std::size_t D>
+struct DaryHeapSort {
+  static_assert(D >= 2, "DaryHeapSort requires at least two children");
+
+  static constexpr std::size_t cacheline_size = 64;
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    std::size_t skip = aligned_offset(data, size);
+    T* heap = data + skip;
+    heap_sort(heap, size - skip);
+
+    // insert skipped elements to the sorted rest
+    for (std::size_t i = skip; i-- > 0;) {
+      T* pos = std::lower_bound(data + i + 1, data + size, data[i]);
+      std::rotate(data + i, data + i + 1, pos);
+    }
+  }
+
+ private:
+  static constexpr std::size_t line_elements =
+      sizeof(T) < cacheline_size ? cacheline_size / sizeof(T) : 1;
+
+  /** amount of elements to skip, so that every child group(starting from
+   *  first child of the root) begins on group boundary
+   */
+  static std::size_t aligned_offset(const T* data, std::size_t size) {
+    constexpr std::size_t group = D * sizeof(T);
+    if (group > cacheline_size || cacheline_size % group != 0) return 0;
+
+    auto addr = reinterpret_cast<std::uintptr_t>(data + 1);
+    std::size_t gap = (group - addr % group) % group;
+    if (gap % sizeof(T) != 0) return 0;
+
+    std::size_t skip = gap / sizeof(T);
+    return skip < size ? skip : 0;
+  }
+
+  void sift_down(T* heap, std::size_t size, std::size_t top, T value) const {
+    std::size_t hole = top;
+    std::size_t first = D * hole + 1;
+
+    while (first < size) {
+      std::size_t last = std::min(first + D, size);
+
+      // grandchildren are D * D consecutive elements
+      std::size_t grand_first = D * first + 1;
+      std::size_t grand_last = std::min(grand_first + D * D, size);
+      for (std::size_t g = grand_first; g < grand_last; g += line_elements)
+        detail::prefetch(heap + g);
+
+      std::size_t best = first;
+      for (std::size_t c = first + 1; c < last; ++c)
+        best = heap[best] < heap[c] ? c : best;
+
+      heap[hole] = std::move(heap[best]);
+      hole = best;
+      first = D * hole + 1;
+    }
+
+    while (hole > top) {
+      std::size_t parent = (hole - 1) / D;
+      if (!(heap[parent] < value)) break;
+
+      heap[hole] = std::move(heap[parent]);
+      hole = parent;
+    }
+    heap[hole] = std::move(value);
+  }
+
+  void heap_sort(T* heap, std::size_t size) const {
+    if (size < 2) return;
+
+    for (std::size_t i = (size - 2) / D + 1; i-- > 0;)
+      sift_down(heap, size, i, std::move(heap[i]));
+
+    for (std::size_t i = size - 1; i > 0; --i) {
+      T value = std::move(heap[i]);
+      heap[i] = std::move(heap[0]);
+      sift_down(heap, i, 0, std::move(value));
+    }
+  }
 };
 
 template <typename T>
-struct RadixSort {
-  void operator()(T* data, std::size_t size) const {}
+using QuaternaryHeapSort = DaryHeapSort<T, 4>;
+
+template <typename T>
+using OctonaryHeapSort = DaryHeapSort<T, 8>;
+
+/** stable bottom-up merge sort without buffer: insertion sorted blocks are
+ *  merged with SymMerge(Kim, Kutzner), which splits both runs by binary
+ *  search and swaps the middle parts with rotation, its recursion takes
+ *  O(log n) stack and sorting takes O(n log^2 n) time, merges that fit to
+ *  optional caller-provided buffer are done with plain buffered merge
+ */
+template <typename T>
+struct InPlaceMergeSort {
+  /** size of insertion sorted blocks */
+  static constexpr std::size_t block_size = 20;
+
+  InPlaceMergeSort() = default;
+  /** use external buffer for merges, where one of the runs fits to it */
+  InPlaceMergeSort(T* buffer, std::size_t capacity)
+      : buffer_{buffer}, capacity_{capacity} {}
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    for (std::size_t lo = 0; lo < size; lo += block_size)
+      InsertionSort<T>{}(data + lo, std::min(block_size, size - lo));
+
+    for (std::size_t width = block_size; width < size; width *= 2) {
+      for (std::size_t lo = 0; lo + width < size; lo += 2 * width)
+        merge(data, lo, lo + width, std::min(lo + 2 * width, size));
+    }
+  }
+
+ private:
+  T* buffer_{nullptr};
+  std::size_t capacity_{0};
+
+  /** merges sorted [a, m) and [m, b) */
+  void merge(T* data, std::size_t a, std::size_t m, std::size_t b) const {
+    if (a == m || m == b || !(data[m] < data[m - 1])) return;
+
+    if (m - a <= capacity_) return merge_lo(data, a, m, b);
+    if (b - m <= capacity_) return merge_hi(data, a, m, b);
+
+    if (m - a == 1) {
+      // insert data[a] to [m, b), after smaller elements
+      std::size_t pos = lower_bound(data, m, b, data[a]);
+      std::rotate(data + a, data + a + 1, data + pos);
+      return;
+    }
+    if (b - m == 1) {
+      // insert data[m] to [a, m), after not greater elements
+      std::size_t pos = upper_bound(data, a, m, data[m]);
+      std::rotate(data + pos, data + m, data + b);
+      return;
+    }
+
+    // find split, such that [start, m) and [m, end) are to be swapped
+    std::size_t mid = a + (b - a) / 2;
+    std::size_t n = mid + m;
+    std::size_t start = m > mid ? n - b : a;
+    std::size_t r = m > mid ? mid : m;
+    std::size_t p = n - 1;
+
+    while (start < r) {
+      std::size_t c = start + (r - start) / 2;
+      if (!(data[p - c] < data[c])) {
+        start = c + 1;
+      } else {
+        r = c;
+      }
+    }
+    std::size_t end = n - start;
+
+    if (start < m && m < end) std::rotate(data + start, data + m, data + end);
+    if (a < start && start < mid) merge(data, a, start, mid);
+    if (mid < end && end < b) merge(data, mid, end, b);
+  }
+
+  /** first position in [lo, hi), where element is not less than key */
+  static std::size_t lower_bound(const T* data, std::size_t lo,
+                                 std::size_t hi, const T& key) {
+    const T* pos = std::lower_bound(data + lo, data + hi, key);
+    return static_cast<std::size_t>(pos - data);
+  }
+
+  /** first position in [lo, hi), where element is greater than key */
+  static std::size_t upper_bound(const T* data, std::size_t lo,
+                                 std::size_t hi, const T& key) {
+    const T* pos = std::upper_bound(data + lo, data + hi, key);
+    return static_cast<std::size_t>(pos - data);
+  }
+
+  /** buffered merge, [a, m) is moved out */
+  void merge_lo(T* data, std::size_t a, std::size_t m, std::size_t b) const {
+    std::move(data + a, data + m, buffer_);
+
+    T* left = buffer_;
+    T* left_end = buffer_ + (m - a);
+    T* right = data + m;
+    T* dest = data + a;
+    while (left < left_end && right < data + b) {
+      if (*right < *left) {
+        *dest++ = std::move(*right++);
+      } else {
+        *dest++ = std::move(*left++);
+      }
+    }
+    std::move(left, left_end, dest);
+  }
+
+  /** buffered merge, [m, b) is moved out, fills from the right */
+  void merge_hi(T* data, std::size_t a, std::size_t m, std::size_t b) const {
+    std::move(data + m, data + b, buffer_);
+
+    std::size_t left = m;  // one past the next element of [a, m)
+    std::size_t right = b - m;  // same for buffer
+    std::size_t dest = b;
+    while (left > a && right > 0) {
+      if (buffer_[right - 1] < data[left - 1]) {
+        data[--dest] = std::move(data[--left]);
+      } else {
+        data[--dest] = std::move(buffer_[--right]);
+      }
+    }
+    std::move(buffer_, buffer_ + right, data + (dest - right));
+  }
 };
 
+/** adaptive natural merge sort(TimSort): finds ascending and strictly
+ *  descending(reversed in place) runs, extends short ones to minrun with
+ *  BinaryInsertionSort, merges them on a run stack with the usual invariants
+ *  and gallops when one run keeps winning, scratch buffer is owned by functor
+ *  and reused between calls
+ */
 template <typename T>
-struct BucketSort {
-  void operator()(T* data, std::size_t size) const {}
+struct TimSort {
+  /** arrays shorter than that are sorted with BinaryInsertionSort only */
+  static constexpr std::size_t min_merge = 64;
+  /** initial amount of wins in a row, after which merge starts galloping */
+  static constexpr std::size_t min_gallop = 7;
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    if (size < min_merge) {
+      count_run(data, 0, size);
+      return BinaryInsertionSort<T>{}(data, size);
+    }
+
+    State st{data, buffer_};
+    std::size_t minrun = min_run_length(size);
+    std::size_t lo = 0;
+    std::size_t remaining = size;
+
+    while (remaining != 0) {
+      std::size_t run = count_run(data, lo, size);
+      if (run < minrun) {
+        run = std::min(remaining, minrun);
+        BinaryInsertionSort<T>{}(data + lo, run);
+      }
+
+      st.push_run(lo, run);
+      st.merge_collapse();
+
+      lo += run;
+      remaining -= run;
+    }
+
+    st.merge_force_collapse();
+  }
+
+ private:
+  mutable std::vector<T> buffer_;
+
+  /** minrun in [min_merge / 2, min_merge], so that size / minrun is close to
+   *  power of two
+   */
+  static std::size_t min_run_length(std::size_t size) noexcept {
+    std::size_t r = 0;
+    while (size >= min_merge) {
+      r |= size & 1;
+      size >>= 1;
+    }
+    return size + r;
+  }
+
+  /** length of run starting at lo, descending run is made ascending */
+  static std::size_t count_run(T* data, std::size_t lo, std::size_t hi) {
+    std::size_t run_hi = lo + 1;
+    if (run_hi == hi) return 1;
+
+    if (data[run_hi] < data[lo]) {
+      ++run_hi;
+      while (run_hi < hi && data[run_hi] < data[run_hi - 1]) ++run_hi;
+      std::reverse(data + lo, data + run_hi);
+    } else {
+      ++run_hi;
+      while (run_hi < hi && !(data[run_hi] < data[run_hi - 1])) ++run_hi;
+    }
+
+    return run_hi - lo;
+  }
+
+  /** position of key in sorted a[0, len), before equal elements, search
+   *  starts with exponential steps from hint
+   */
+  static std::size_t gallop_left(const T& key, const T* a, std::size_t len,
+                                 std::size_t hint) {
+    std::size_t last_ofs = 0, ofs = 1;
+
+    if (a[hint] < key) {
+      // a[hint + last_ofs] < key <= a[hint + ofs]
+      std::size_t max_ofs = len - hint;
+      while (ofs < max_ofs && a[hint + ofs] < key) {
+        last_ofs = ofs;
+        ofs = (ofs << 1) + 1;
+      }
+      if (ofs > max_ofs) ofs = max_ofs;
+
+      last_ofs += hint + 1;
+      ofs += hint;
+    } else {
+      // a[hint - ofs] < key <= a[hint - last_ofs]
+      std::size_t max_ofs = hint + 1;
+      while (ofs < max_ofs && !(a[hint - ofs] < key)) {
+        last_ofs = ofs;
+        ofs = (ofs << 1) + 1;
+      }
+      if (ofs > max_ofs) ofs = max_ofs;
+
+      std::size_t tmp = last_ofs;
+      last_ofs = hint + 1 - ofs;
+      ofs = hint - tmp;
+    }
+
+    // a[last_ofs - 1] < key <= a[ofs]
+    while (last_ofs < ofs) {
+      std::size_t m = last_ofs + (ofs - last_ofs) / 2;
+      if (a[m] < key) {
+        last_ofs = m + 1;
+      } else {
+        ofs = m;
+      }
+    }
+    return ofs;
+  }
+
+  /** position of key in sorted a[0, len), after equal elements, search
+   *  starts with exponential steps from hint
+   */
+  static std::size_t gallop_right(const T& key, const T* a, std::size_t len,
+                                  std::size_t hint) {
+    std::size_t last_ofs = 0, ofs = 1;
+
+    if (key < a[hint]) {
+      // a[hint - ofs] <= key < a[hint - last_ofs]
+      std::size_t max_ofs = hint + 1;
+      while (ofs < max_ofs && key < a[hint - ofs]) {
+        last_ofs = ofs;
+        ofs = (ofs << 1) + 1;
+      }
+      if (ofs > max_ofs) ofs = max_ofs;
+
+      std::size_t tmp = last_ofs;
+      last_ofs = hint + 1 - ofs;
+      ofs = hint - tmp;
+    } else {
+      // a[hint + last_ofs] <= key < a[hint + ofs]
+      std::size_t max_ofs = len - hint;
+      while (ofs < max_ofs && !(key < a[hint + ofs])) {
+        last_ofs = ofs;
+        ofs = (ofs << 1) + 1;
+      }
+      if (ofs > max_ofs) ofs = max_ofs;
+
+      last_ofs += hint + 1;
+      ofs += hint;
+    }
+
+    // a[last_ofs - 1] <= key < a[ofs]
+    while (last_ofs < ofs) {
+      std::size_t m = last_ofs + (ofs - last_ofs) / 2;
+      if (key < a[m]) {
+        ofs = m;
+      } else {
+        last_ofs = m + 1;
+      }
+    }
+    return ofs;
+  }
+
+  /** state of one sort: pending runs and adaptive galloping threshold */
+  struct State {
+    /** enough for 2^64 elements, run lengths grow at least as fibonacci */
+    static constexpr std::size_t max_runs = 96;
+
+    T* data;
+    std::vector<T>& buffer;
+    std::ptrdiff_t gallop{static_cast<std::ptrdiff_t>(min_gallop)};
+
+    std::size_t run_base[max_runs];
+    std::size_t run_len[max_runs];
+    std::size_t runs{0};
+
+    State(T* d, std::vector<T>& b) : data{d}, buffer{b} {}
+
+    void push_run(std::size_t base, std::size_t len) {
+      run_base[runs] = base;
+      run_len[runs] = len;
+      ++runs;
+    }
+
+    /** merges until len[k - 2] > len[k - 1] + len[k] and len[k - 1] > len[k]
+     *  hold for the top of the stack
+     */
+    void merge_collapse() {
+      while (runs > 1) {
+        std::size_t k = runs - 2;
+        if ((k > 0 && run_len[k - 1] <= run_len[k] + run_len[k + 1]) ||
+            (k > 1 && run_len[k - 2] <= run_len[k - 1] + run_len[k])) {
+          if (run_len[k - 1] < run_len[k + 1]) --k;
+        } else if (run_len[k] > run_len[k + 1]) {
+          break;
+        }
+        merge_at(k);
+      }
+    }
+
+    void merge_force_collapse() {
+      while (runs > 1) {
+        std::size_t k = runs - 2;
+        if (k > 0 && run_len[k - 1] < run_len[k + 1]) --k;
+        merge_at(k);
+      }
+    }
+
+    T* scratch(std::size_t size) {
+      if (buffer.size() < size) buffer.resize(size);
+      return buffer.data();
+    }
+
+    /** merges runs k and k + 1 */
+    void merge_at(std::size_t k) {
+      std::size_t base1 = run_base[k], len1 = run_len[k];
+      std::size_t base2 = run_base[k + 1], len2 = run_len[k + 1];
+
+      run_len[k] = len1 + len2;
+      if (k == runs - 3) {
+        run_base[k + 1] = run_base[k + 2];
+        run_len[k + 1] = run_len[k + 2];
+      }
+      --runs;
+
+      // elements of run1 before first element of run2 are already in place
+      std::size_t skip = gallop_right(data[base2], data + base1, len1, 0);
+      base1 += skip;
+      len1 -= skip;
+      if (len1 == 0) return;
+
+      // elements of run2 after last element of run1 are already in place
+      len2 = gallop_left(data[base1 + len1 - 1], data + base2, len2, len2 - 1);
+      if (len2 == 0) return;
+
+      if (len1 <= len2) {
+        merge_lo(base1, len1, base2, len2);
+      } else {
+        merge_hi(base1, len1, base2, len2);
+      }
+    }
+
+    /** merge, that moves shorter run1 out to buffer and fills from the left,
+     *  first element of run1 is greater than first of run2, last element of
+     *  run1 is greater than every element of run2
+     */
+    void merge_lo(std::size_t base1, std::size_t len1, std::size_t base2,
+                  std::size_t len2) {
+      T* tmp = scratch(len1);
+      std::move(data + base1, data + base1 + len1, tmp);
+
+      std::size_t cursor1 = 0, cursor2 = base2, dest = base1;
+      data[dest++] = std::move(data[cursor2++]);
+      if (--len2 == 0) {
+        std::move(tmp + cursor1, tmp + cursor1 + len1, data + dest);
+        return;
+      }
+      if (len1 == 1) {
+        std::move(data + cursor2, data + cursor2 + len2, data + dest);
+        data[dest + len2] = std::move(tmp[cursor1]);
+        return;
+      }
+
+      // returns, when one of the runs is exhausted
+      [&] {
+        while (true) {
+          std::size_t count1 = 0, count2 = 0;
+
+          // one element at a time, until one run wins gallop times in a row
+          do {
+            if (data[cursor2] < tmp[cursor1]) {
+              data[dest++] = std::move(data[cursor2++]);
+              ++count2;
+              count1 = 0;
+              if (--len2 == 0) return;
+            } else {
+              data[dest++] = std::move(tmp[cursor1++]);
+              ++count1;
+              count2 = 0;
+              if (--len1 == 1) return;
+            }
+          } while (static_cast<std::ptrdiff_t>(count1 | count2) < gallop);
+
+          // galloping, until it stops paying off
+          do {
+            count1 = gallop_right(data[cursor2], tmp + cursor1, len1, 0);
+            if (count1 != 0) {
+              std::move(tmp + cursor1, tmp + cursor1 + count1, data + dest);
+              dest += count1;
+              cursor1 += count1;
+              len1 -= count1;
+              if (len1 <= 1) return;
+            }
+            data[dest++] = std::move(data[cursor2++]);
+            if (--len2 == 0) return;
+
+            count2 = gallop_left(tmp[cursor1], data + cursor2, len2, 0);
+            if (count2 != 0) {
+              std::move(data + cursor2, data + cursor2 + count2, data + dest);
+              dest += count2;
+              cursor2 += count2;
+              len2 -= count2;
+              if (len2 == 0) return;
+            }
+            data[dest++] = std::move(tmp[cursor1++]);
+            if (--len1 == 1) return;
+
+            --gallop;
+          } while (count1 >= min_gallop || count2 >= min_gallop);
+
+          if (gallop < 0) gallop = 0;
+          gallop += 2;  // penalty for leaving galloping mode
+        }
+      }();
+
+      if (gallop < 1) gallop = 1;
+
+      if (len1 == 1) {
+        std::move(data + cursor2, data + cursor2 + len2, data + dest);
+        data[dest + len2] = std::move(tmp[cursor1]);
+      } else {
+        std::move(tmp + cursor1, tmp + cursor1 + len1, data + dest);
+      }
+    }
+
+    /** merge, that moves shorter run2 out to buffer and fills from the right,
+     *  symmetric to merge_lo(cursors are signed, as they go below base1)
+     */
+    void merge_hi(std::size_t base1, std::size_t len1, std::size_t base2,
+                  std::size_t len2) {
+      T* tmp = scratch(len2);
+      std::move(data + base2, data + base2 + len2, tmp);
+
+      using Idx = std::ptrdiff_t;
+      Idx cursor1 = static_cast<Idx>(base1 + len1) - 1;
+      Idx cursor2 = static_cast<Idx>(len2) - 1;
+      Idx dest = static_cast<Idx>(base2 + len2) - 1;
+
+      data[dest--] = std::move(data[cursor1--]);
+      if (--len1 == 0) {
+        std::move(tmp, tmp + len2, data + (dest + 1 - static_cast<Idx>(len2)));
+        return;
+      }
+      if (len2 == 1) {
+        dest -= static_cast<Idx>(len1);
+        cursor1 -= static_cast<Idx>(len1);
+        std::move_backward(data + (cursor1 + 1), data + (cursor1 + 1) + len1,
+                           data + (dest + 1) + len1);
+        data[dest] = std::move(tmp[cursor2]);
+        return;
+      }
+
+      [&] {
+        while (true) {
+          std::size_t count1 = 0, count2 = 0;
+
+          do {
+            if (tmp[cursor2] < data[cursor1]) {
+              data[dest--] = std::move(data[cursor1--]);
+              ++count1;
+              count2 = 0;
+              if (--len1 == 0) return;
+            } else {
+              data[dest--] = std::move(tmp[cursor2--]);
+              ++count2;
+              count1 = 0;
+              if (--len2 == 1) return;
+            }
+          } while (static_cast<std::ptrdiff_t>(count1 | count2) < gallop);
+
+          do {
+            count1 = len1 - gallop_right(tmp[cursor2], data + base1, len1,
+                                         len1 - 1);
+            if (count1 != 0) {
+              dest -= static_cast<Idx>(count1);
+              cursor1 -= static_cast<Idx>(count1);
+              len1 -= count1;
+              std::move_backward(data + (cursor1 + 1),
+                                 data + (cursor1 + 1) + count1,
+                                 data + (dest + 1) + count1);
+              if (len1 == 0) return;
+            }
+            data[dest--] = std::move(tmp[cursor2--]);
+            if (--len2 == 1) return;
+
+            count2 = len2 - gallop_left(data[cursor1], tmp, len2, len2 - 1);
+            if (count2 != 0) {
+              dest -= static_cast<Idx>(count2);
+              cursor2 -= static_cast<Idx>(count2);
+              len2 -= count2;
+              std::move(tmp + (cursor2 + 1), tmp + (cursor2 + 1) + count2,
+                        data + (dest + 1));
+              if (len2 <= 1) return;
+            }
+            data[dest--] = std::move(data[cursor1--]);
+            if (--len1 == 0) return;
+
+            --gallop;
+          } while (count1 >= min_gallop || count2 >= min_gallop);
+
+          if (gallop < 0) gallop = 0;
+          gallop += 2;
+        }
+      }();
+
+      if (gallop < 1) gallop = 1;
+
+      if (len2 == 1) {
+        dest -= static_cast<Idx>(len1);
+        cursor1 -= static_cast<Idx>(len1);
+        std::move_backward(data + (cursor1 + 1), data + (cursor1 + 1) + len1,
+                           data + (dest + 1) + len1);
+        data[dest] = std::move(tmp[cursor2]);
+      } else {
+        std::move(tmp, tmp + len2, data + (dest + 1 - static_cast<Idx>(len2)));
+      }
+    }
+  };
+};
+
+/** introsort: quicksort with median of three(ninther for large ranges) pivot,
+ *  recursion only into the smaller part, insertion sort for small partitions
+ *  and HeapSort fallback after 2 * log2(size) levels of partitioning
+ */
+template <typename T>
+struct QuickSort {
+  /** partitions of that size and less are finished with InsertionSort */
+  static constexpr std::size_t small_partition = 16;
+  /** partitions larger than that take ninther as pivot */
+  static constexpr std::size_t ninther_threshold = 128;
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    return quick_sort(data, 0, size - 1, 2 * detail::log2(size));
+  }
+
+  /** Hoare-style partition of [low, high] around selected pivot, returns
+   *  pivot's final position
+   */
+  std::size_t partition(T* data, std::size_t low, std::size_t high) const {
+    std::swap(data[low], data[select_pivot(data, low, high)]);
+    const T& pivot = data[low];
+
+    std::size_t i = low, j = high + 1;
+    while (true) {
+      while (data[++i] < pivot)
+        if (i == high) break;
+      while (pivot < data[--j]) {
+      }
+
+      if (i >= j) break;
+      std::swap(data[i], data[j]);
+    }
+    std::swap(data[low], data[j]);
+
+    return j;
+  }
+
+  void quick_sort(T* data, std::size_t low, std::size_t high,
+                  std::size_t depth) const {
+    while (high - low + 1 > small_partition) {
+      if (depth == 0) return HeapSort<T>{}(data + low, high - low + 1);
+      --depth;
+
+      std::size_t pi = partition(data, low, high);
+      if (pi - low < high - pi) {
+        if (pi > low) quick_sort(data, low, pi - 1, depth);
+        low = pi + 1;
+      } else {
+        if (pi < high) quick_sort(data, pi + 1, high, depth);
+        high = pi - 1;
+      }
+    }
+
+    InsertionSort<T>{}(data + low, high - low + 1);
+  }
+
+  /** index of median of three(ninther for large ranges) in [low, high] */
+  static std::size_t select_pivot(const T* data, std::size_t low,
+                                  std::size_t high) {
+    std::size_t len = high - low + 1;
+    std::size_t mid = low + len / 2;
+    if (len <= ninther_threshold) {
+      return median_of_three(data, low, mid, high);
+    }
+
+    std::size_t step = len / 8;
+    return median_of_three(
+        data, median_of_three(data, low, low + step, low + 2 * step),
+        median_of_three(data, mid - step, mid, mid + step),
+        median_of_three(data, high - 2 * step, high - step, high));
+  }
+
+ private:
+  static std::size_t median_of_three(const T* data, std::size_t a,
+                                     std::size_t b, std::size_t c) {
+    if (data[a] < data[b]) {
+      if (data[b] < data[c]) return b;
+      return data[a] < data[c] ? c : a;
+    }
+    if (data[a] < data[c]) return a;
+    return data[b] < data[c] ? c : b;
+  }
+};
+
+/** quicksort with three way(Bentley-McIlroy) partitioning: keys equal to
+ *  pivot are gathered at the ends during partitioning, swapped to the middle
+ *  afterwards and left out of recursion, so k distinct keys take O(n log k)
+ */
+template <typename T>
+struct ThreeWayQuickSort {
+  /** partitions of that size and less are finished with InsertionSort */
+  static constexpr std::size_t small_partition = 16;
+
+  void operator()(T* data, std::size_t size) const {
+    return three_way_sort(data, size, 2 * detail::log2(size));
+  }
+
+ private:
+  void three_way_sort(T* data, std::size_t size, std::size_t depth) const {
+    while (size > small_partition) {
+      if (depth == 0) return HeapSort<T>{}(data, size);
+      --depth;
+
+      std::size_t high = size - 1;
+      std::swap(data[0], data[QuickSort<T>::select_pivot(data, 0, high)]);
+      const T& pivot = data[0];
+
+      // [0, p] and [q, high] are equal to pivot during partitioning
+      std::size_t i = 0, j = size, p = 0, q = size;
+      while (true) {
+        while (data[++i] < pivot)
+          if (i == high) break;
+        while (pivot < data[--j]) {
+        }
+
+        // data[j] is not greater than pivot and, unless the scan stopped at
+        // high, data[i] is not less, so one comparison tells equality
+        if (i == j && !(data[i] < pivot)) std::swap(data[++p], data[i]);
+        if (i >= j) break;
+
+        std::swap(data[i], data[j]);
+        if (!(data[i] < pivot)) std::swap(data[++p], data[i]);
+        if (!(pivot < data[j])) std::swap(data[--q], data[j]);
+      }
+
+      std::size_t less = j - p;
+      std::size_t greater = q - j - 1;
+      for (std::size_t k = 0; k <= p; ++k) std::swap(data[k], data[j - k]);
+      for (std::size_t k = 0; k < size - q; ++k)
+        std::swap(data[high - k], data[j + 1 + k]);
+
+      T* greater_data = data + (size - greater);
+      if (less < greater) {
+        three_way_sort(data, less, depth);
+        data = greater_data;
+        size = greater;
+      } else {
+        three_way_sort(greater_data, greater, depth);
+        size = less;
+      }
+    }
+
+    InsertionSort<T>{}(data, size);
+  }
+};
+
+/** dual pivot quicksort(Yaroslavskiy), splits range into three parts:
+ *  less than first pivot, between pivots and greater than second pivot,
+ *  pivots are second and fourth of five sorted samples, small partitions are
+ *  finished with InsertionSort and deep recursion falls back to HeapSort
+ */
+template <typename T>
+struct DualPivotQuickSort {
+  /** partitions of that size and less are finished with InsertionSort */
+  static constexpr std::size_t small_partition = 27;
+
+  void operator()(T* data, std::size_t size) const {
+    return dual_pivot_sort(data, size, 2 * detail::log2(size));
+  }
+
+ private:
+  void dual_pivot_sort(T* data, std::size_t size, std::size_t depth) const {
+    if (size <= small_partition) return InsertionSort<T>{}(data, size);
+    if (depth == 0) return HeapSort<T>{}(data, size);
+    --depth;
+
+    select_pivots(data, size);
+    const T& p = data[0];
+    const T& q = data[size - 1];
+
+    std::size_t lt = 1, gt = size - 2, k = 1;
+    while (k <= gt) {
+      if (data[k] < p) {
+        std::swap(data[k], data[lt]);
+        ++lt;
+      } else if (q < data[k]) {
+        while (q < data[gt] && k < gt) --gt;
+        std::swap(data[k], data[gt]);
+        --gt;
+
+        if (data[k] < p) {
+          std::swap(data[k], data[lt]);
+          ++lt;
+        }
+      }
+      ++k;
+    }
+    --lt;
+    ++gt;
+
+    bool distinct_pivots = p < q;
+    std::swap(data[0], data[lt]);
+    std::swap(data[size - 1], data[gt]);
+
+    dual_pivot_sort(data, lt, depth);
+    // with equal pivots middle part consists of equal elements
+    if (distinct_pivots) dual_pivot_sort(data + lt + 1, gt - lt - 1, depth);
+    dual_pivot_sort(data + gt + 1, size - gt - 1, depth);
+  }
+
+  /** sorts five evenly spaced samples and moves second and fourth of them to
+   *  the first and the last positions
+   */
+  void select_pivots(T* data, std::size_t size) const {
+    std::size_t step = size / 6;
+    std::size_t samples[5] = {step, 2 * step, 3 * step, 4 * step, 5 * step};
+
+    for (std::size_t i = 1; i < 5; ++i)
+      for (std::size_t j = i; j > 0 && data[samples[j]] < data[samples[j - 1]];
+           --j)
+        std::swap(data[samples[j]], data[samples[j - 1]]);
+
+    std::swap(data[0], data[samples[1]]);
+    std::swap(data[size - 1], data[samples[3]]);
+  }
+};
+
+/*
+ * PdqSort is an altered port of pdqsort.h(https://github.com/orlp/pdqsort),
+ * adapted to the functor interface of this library, its notice follows.
+ *
+ * pdqsort.h - Pattern-defeating quicksort.
+ *
+ * Copyright (c) 2021 Orson Peters
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software in
+ *    a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ *
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ *
+ * 3. This notice may not be removed or altered from any source distribution.
+ */
+
+/** pattern-defeating quicksort(pdqsort): BlockQuicksort-style branchless
+ *  partitioning, which stores offsets of misplaced elements in small blocks
+ *  and swaps them afterwards, already partitioned ranges are finished with
+ *  bounded insertion sort, runs of elements equal to previous pivot are split
+ *  off without recursion, and too many unbalanced partitions lead to HeapSort
+ */
+template <typename T>
+struct PdqSort {
+  static constexpr std::size_t insertion_sort_threshold = 24;
+  static constexpr std::size_t ninther_threshold = 128;
+  /** maximal amount of moves in insertion sort of already partitioned range */
+  static constexpr std::size_t partial_insertion_sort_limit = 8;
+  /** amount of elements, which offsets are stored in one block */
+  static constexpr std::size_t block_size = 64;
+  static constexpr std::size_t cacheline_size = 64;
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    return pdq_sort(data, data + size, detail::log2(size), true);
+  }
+
+ private:
+  static void sort2(T* a, T* b) {
+    if (*b < *a) std::swap(*a, *b);
+  }
+
+  static void sort3(T* a, T* b, T* c) {
+    sort2(a, b);
+    sort2(b, c);
+    sort2(a, b);
+  }
+
+  /** insertion sort of [begin, end), that relies on *(begin - 1) being not
+   *  greater than any element of range when guarded is false
+   */
+  static void insertion_sort(T* begin, T* end, bool guarded) {
+    for (T* cur = begin + 1; cur < end; ++cur) {
+      if (!(*cur < *(cur - 1))) continue;
+
+      T tmp = std::move(*cur);
+      T* sift = cur;
+      do {
+        *sift = std::move(*(sift - 1));
+        --sift;
+      } while ((!guarded || sift != begin) && tmp < *(sift - 1));
+      *sift = std::move(tmp);
+    }
+  }
+
+  /** insertion sort, that gives up after partial_insertion_sort_limit moves,
+   *  returns true if range got sorted
+   */
+  static bool partial_insertion_sort(T* begin, T* end) {
+    std::size_t limit = 0;
+    for (T* cur = begin + 1; cur < end; ++cur) {
+      if (!(*cur < *(cur - 1))) continue;
+
+      T tmp = std::move(*cur);
+      T* sift = cur;
+      do {
+        *sift = std::move(*(sift - 1));
+        --sift;
+      } while (sift != begin && tmp < *(sift - 1));
+      *sift = std::move(tmp);
+
+      limit += static_cast<std::size_t>(cur - sift);
+      if (limit > partial_insertion_sort_limit) return false;
+    }
+
+    return true;
+  }
+
+  static unsigned char* align_cacheline(unsigned char* ptr) {
+    auto addr = reinterpret_cast<std::uintptr_t>(ptr);
+    addr = (addr + cacheline_size - 1) & ~(std::uintptr_t{cacheline_size} - 1);
+    return reinterpret_cast<unsigned char*>(addr);
+  }
+
+  /** swaps num pairs first[offsets_l[i]] and last[-offsets_r[i]], as cyclic
+   *  permutation(less moves) when it is allowed
+   */
+  static void swap_offsets(T* first, T* last, const unsigned char* offsets_l,
+                           const unsigned char* offsets_r, std::size_t num,
+                           bool use_swaps) {
+    if (use_swaps) {
+      // proper swapping keeps descending sequences O(n)
+      for (std::size_t i = 0; i < num; ++i)
+        std::swap(first[offsets_l[i]], *(last - offsets_r[i]));
+    } else if (num > 0) {
+      T* l = first + offsets_l[0];
+      T* r = last - offsets_r[0];
+      T tmp = std::move(*l);
+      *l = std::move(*r);
+      for (std::size_t i = 1; i < num; ++i) {
+        l = first + offsets_l[i];
+        *r = std::move(*l);
+        r = last - offsets_r[i];
+        *l = std::move(*r);
+      }
+      *r = std::move(tmp);
+    }
+  }
+
+  /** partitions [begin, end) around *begin, elements equal to pivot go to the
+   *  right part, returns pivot position and whether range was partitioned
+   */
+  static std::pair<T*, bool> partition_right(T* begin, T* end) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+
+    // median of three guarantees, that element not less than pivot exists
+    while (*++first < pivot) {
+    }
+
+    if (first - 1 == begin) {
+      while (first < last && !(*--last < pivot)) {
+      }
+    } else {
+      while (!(*--last < pivot)) {
+      }
+    }
+
+    bool already_partitioned = first >= last;
+    if (!already_partitioned) {
+      std::swap(*first, *last);
+      ++first;
+
+      unsigned char offsets_l_storage[block_size + cacheline_size];
+      unsigned char offsets_r_storage[block_size + cacheline_size];
+      unsigned char* offsets_l = align_cacheline(offsets_l_storage);
+      unsigned char* offsets_r = align_cacheline(offsets_r_storage);
+
+      T* offsets_l_base = first;
+      T* offsets_r_base = last;
+      std::size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+      while (first < last) {
+        // number of elements, scanned into each offsets block
+        std::size_t num_unknown = static_cast<std::size_t>(last - first);
+        std::size_t left_split =
+            num_l == 0 ? (num_r == 0 ? num_unknown / 2 : num_unknown) : 0;
+        std::size_t right_split = num_r == 0 ? (num_unknown - left_split) : 0;
+
+        // no branches depend on comparisons while filling the blocks
+        std::size_t left_count = std::min(left_split, block_size);
+        for (std::size_t i = 0; i < left_count; ++i) {
+          offsets_l[num_l] = static_cast<unsigned char>(i);
+          num_l += !(*first < pivot);
+          ++first;
+        }
+
+        std::size_t right_count = std::min(right_split, block_size);
+        for (std::size_t i = 1; i <= right_count; ++i) {
+          offsets_r[num_r] = static_cast<unsigned char>(i);
+          num_r += *--last < pivot;
+        }
+
+        std::size_t num = std::min(num_l, num_r);
+        swap_offsets(offsets_l_base, offsets_r_base, offsets_l + start_l,
+                     offsets_r + start_r, num, num_l == num_r);
+        num_l -= num;
+        num_r -= num;
+        start_l += num;
+        start_r += num;
+
+        if (num_l == 0) {
+          start_l = 0;
+          offsets_l_base = first;
+        }
+        if (num_r == 0) {
+          start_r = 0;
+          offsets_r_base = last;
+        }
+      }
+
+      // one of the blocks may still have misplaced elements
+      if (num_l) {
+        offsets_l += start_l;
+        while (num_l--) std::swap(offsets_l_base[offsets_l[num_l]], *--last);
+        first = last;
+      }
+      if (num_r) {
+        offsets_r += start_r;
+        while (num_r--) {
+          std::swap(*(offsets_r_base - offsets_r[num_r]), *first);
+          ++first;
+        }
+        last = first;
+      }
+    }
+
+    T* pivot_pos = first - 1;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+
+    return {pivot_pos, already_partitioned};
+  }
+
+  /** partitions [begin, end) around *begin, elements equal to pivot go to the
+   *  left part, returns pivot position
+   */
+  static T* partition_left(T* begin, T* end) {
+    T pivot = std::move(*begin);
+    T* first = begin;
+    T* last = end;
+
+    while (pivot < *--last) {
+    }
+
+    if (last + 1 == end) {
+      while (first < last && !(pivot < *++first)) {
+      }
+    } else {
+      while (!(pivot < *++first)) {
+      }
+    }
+
+    while (first < last) {
+      std::swap(*first, *last);
+      while (pivot < *--last) {
+      }
+      while (!(pivot < *++first)) {
+      }
+    }
+
+    T* pivot_pos = last;
+    *begin = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+
+    return pivot_pos;
+  }
+
+  /** shuffles some elements of unbalanced part to break patterns */
+  static void break_patterns(T* begin, T* end) {
+    std::size_t size = static_cast<std::size_t>(end - begin);
+    if (size < insertion_sort_threshold) return;
+
+    std::swap(*begin, *(begin + size / 4));
+    std::swap(*(end - 1), *(end - size / 4));
+
+    if (size > ninther_threshold) {
+      std::swap(*(begin + 1), *(begin + (size / 4 + 1)));
+      std::swap(*(begin + 2), *(begin + (size / 4 + 2)));
+      std::swap(*(end - 2), *(end - (size / 4 + 1)));
+      std::swap(*(end - 3), *(end - (size / 4 + 2)));
+    }
+  }
+
+  /** leftmost is false, when *(begin - 1) is pivot of previous partition */
+  static void pdq_sort(T* begin, T* end, std::size_t bad_allowed,
+                       bool leftmost) {
+    while (true) {
+      std::size_t size = static_cast<std::size_t>(end - begin);
+
+      if (size < insertion_sort_threshold) {
+        return insertion_sort(begin, end, leftmost);
+      }
+
+      std::size_t s2 = size / 2;
+      if (size > ninther_threshold) {
+        sort3(begin, begin + s2, end - 1);
+        sort3(begin + 1, begin + (s2 - 1), end - 2);
+        sort3(begin + 2, begin + (s2 + 1), end - 3);
+        sort3(begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+        std::swap(*begin, *(begin + s2));
+      } else {
+        sort3(begin + s2, begin, end - 1);
+      }
+
+      // pivot equals to previous one, there is nothing smaller than it in the
+      // range, so elements equal to pivot are already in place
+      if (!leftmost && !(*(begin - 1) < *begin)) {
+        begin = partition_left(begin, end) + 1;
+        continue;
+      }
+
+      auto [pivot_pos, already_partitioned] = partition_right(begin, end);
+
+      std::size_t l_size = static_cast<std::size_t>(pivot_pos - begin);
+      std::size_t r_size = static_cast<std::size_t>(end - (pivot_pos + 1));
+      bool highly_unbalanced = l_size < size / 8 || r_size < size / 8;
+
+      if (highly_unbalanced) {
+        if (--bad_allowed == 0) {
+          return HeapSort<T>{}(begin, size);
+        }
+
+        break_patterns(begin, pivot_pos);
+        break_patterns(pivot_pos + 1, end);
+      } else if (already_partitioned &&
+                 partial_insertion_sort(begin, pivot_pos) &&
+                 partial_insertion_sort(pivot_pos + 1, end)) {
+        return;
+      }
+
+      pdq_sort(begin, pivot_pos, bad_allowed, leftmost);
+      begin = pivot_pos + 1;
+      leftmost = false;
+    }
+  }
+};
+
+/** counting sort for integral keys, histogram is sized to the detected
+ *  [min, max] range, falls back to QuickSort when range is too wide for size,
+ *  elements, that could not be rebuilt from key(with payload), are scattered
+ *  stably through buffer
+ */
+template <typename T>
+struct CountingSort {
+  using K = typename detail::Key<T>::type;
+  static_assert(std::is_integral_v<K> && !std::is_same_v<K, bool>,
+                "CountingSort requires integral keys");
+
+  /** maximal ratio of keys range to array size, that is counted */
+  static constexpr std::size_t range_factor = 4;
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    K min = detail::Key<T>::of(data[0]);
+    K max = min;
+    for (std::size_t i = 1; i < size; ++i) {
+      const K& key = detail::Key<T>::of(data[i]);
+      if (key < min) {
+        min = key;
+      } else if (max < key) {
+        max = key;
+      }
+    }
+
+    U range = static_cast<U>(static_cast<U>(max) - static_cast<U>(min));
+    if (range >= range_factor * size) {
+      return QuickSort<T>{}(data, size);
+    }
+
+    std::vector<std::size_t> counts(static_cast<std::size_t>(range) + 1);
+    for (std::size_t i = 0; i < size; ++i) ++counts[offset(data[i], min)];
+
+    if constexpr (!std::is_convertible_v<K, T>) {
+      std::size_t pos = 0;
+      for (auto& cnt : counts) pos += std::exchange(cnt, pos);
+
+      std::vector<T> buffer(size);
+      for (std::size_t i = 0; i < size; ++i) {
+        buffer[counts[offset(data[i], min)]++] = std::move(data[i]);
+      }
+      std::move(buffer.begin(), buffer.end(), data);
+    } else {
+      std::size_t k = 0;
+      for (std::size_t d = 0; d < counts.size(); ++d) {
+        K key = static_cast<K>(static_cast<U>(static_cast<U>(min) + d));
+        for (std::size_t cnt = counts[d]; cnt > 0; --cnt) data[k++] = key;
+      }
+    }
+  }
+
+ private:
+  using U = std::make_unsigned_t<K>;
+
+  static std::size_t offset(const T& elem, K min) noexcept {
+    return static_cast<U>(static_cast<U>(detail::Key<T>::of(elem)) -
+                          static_cast<U>(min));
+  }
+};
+
+/** least significant digit radix sort for signed and unsigned integral keys,
+ *  byte per pass, passes with the same digit in every element are skipped
+ */
+template <typename T>
+struct RadixSort {
+  using K = typename detail::Key<T>::type;
+  static_assert(std::is_integral_v<K> && !std::is_same_v<K, bool>,
+                "RadixSort requires integral keys");
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    // histograms of every pass in one go through the data
+    std::size_t counts[passes][radix] = {};
+    for (std::size_t i = 0; i < size; ++i) {
+      U key = ukey(data[i]);
+      for (std::size_t p = 0; p < passes; ++p) ++counts[p][digit(key, p)];
+    }
+
+    std::vector<T> buffer;  // ping-pong buffer, allocated on first real pass
+    T* src = data;
+    T* dst = nullptr;
+    U first = ukey(data[0]);
+
+    for (std::size_t p = 0; p < passes; ++p) {
+      std::size_t* offsets = counts[p];
+      if (offsets[digit(first, p)] == size) continue;
+
+      if (dst == nullptr) {
+        buffer.resize(size);
+        dst = buffer.data();
+      }
+
+      std::size_t sum = 0;
+      for (std::size_t d = 0; d < radix; ++d) {
+        std::size_t cnt = offsets[d];
+        offsets[d] = sum;
+        sum += cnt;
+      }
+
+      for (std::size_t i = 0; i < size; ++i)
+        dst[offsets[digit(ukey(src[i]), p)]++] = std::move(src[i]);
+
+      std::swap(src, dst);
+    }
+
+    if (src != data) std::move(src, src + size, data);
+  }
+
+ private:
+  using Radix = detail::RadixKey<T>;
+  using U = typename Radix::U;
+
+  static constexpr std::size_t radix = Radix::radix;
+  static constexpr std::size_t passes = Radix::passes;
+
+  static U ukey(const T& elem) noexcept { return Radix::of(elem); }
+
+  static std::size_t digit(U key, std::size_t pass) noexcept {
+    return Radix::digit(key, pass);
+  }
+};
+
+/** bucket sort for arithmetic(integral and floating point) keys, scatters
+ *  elements to about size / bucket_load buckets of uniform key ranges and
+ *  finishes every bucket with InsertionSort(QuickSort for overfilled ones)
+ */
+template <typename T>
+struct BucketSort {
+  using K = typename detail::Key<T>::type;
+  static_assert(std::is_arithmetic_v<K> && !std::is_same_v<K, bool>,
+                "BucketSort requires arithmetic keys");
+
+  /** expected amount of elements in one bucket */
+  static constexpr std::size_t bucket_load = 4;
+  /** buckets larger than that are sorted with QuickSort */
+  static constexpr std::size_t small_bucket = 32;
+
+  void operator()(T* data, std::size_t size) const {
+    if (size < 2) return;
+
+    K min = detail::Key<T>::of(data[0]);
+    K max = min;
+    for (std::size_t i = 1; i < size; ++i) {
+      const K& key = detail::Key<T>::of(data[i]);
+      if (key < min) {
+        min = key;
+      } else if (max < key) {
+        max = key;
+      }
+    }
+    if (!(min < max)) return;
+
+    std::size_t buckets = std::max<std::size_t>(size / bucket_load, 1);
+    double low = static_cast<double>(min);
+    double scale = static_cast<double>(buckets) /
+                   (static_cast<double>(max) - low);
+
+    auto bucket_of = [=](const T& elem) {
+      double key = static_cast<double>(detail::Key<T>::of(elem));
+      double pos = (key - low) * scale;
+      std::size_t idx = pos > 0 ? static_cast<std::size_t>(pos) : 0;
+      return idx < buckets ? idx : buckets - 1;
+    };
+
+    std::vector<std::size_t> offsets(buckets + 1);
+    for (std::size_t i = 0; i < size; ++i) ++offsets[bucket_of(data[i]) + 1];
+    for (std::size_t b = 0; b < buckets; ++b) offsets[b + 1] += offsets[b];
+
+    std::vector<T> buffer(size);
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < size; ++i)
+      buffer[fill[bucket_of(data[i])]++] = std::move(data[i]);
+
+    for (std::size_t b = 0; b < buckets; ++b) {
+      T* bucket = buffer.data() + offsets[b];
+      std::size_t len = offsets[b + 1] - offsets[b];
+      if (len < 2) continue;
+
+      if (len <= small_bucket) {
+        InsertionSort<T>{}(bucket, len);
+      } else {
+        QuickSort<T>{}(bucket, len);
+      }
+    }
+
+    std::move(buffer.begin(), buffer.end(), data);
+  }
 };
 
 }  // namespace sortings
@@ -0,0 +1,301 @@
+/** @file
+ *  work-stealing thread pool for parallel sortings
+ */
+
+#ifndef SORT_BENCH_THREAD_POOL_HPP
+#define SORT_BENCH_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace srtbch {
+
+/** pool of worker threads, every worker has its own deque of tasks: it takes
+ *  newest tasks from the back of its deque, and steals oldest ones from the
+ *  front of others deques, when its own is empty, threads outside the pool
+ *  share one more deque the same way
+ */
+class ThreadPool {
+ public:
+  using Task = std::function<void()>;
+
+  /** threads - amount of workers, 0 is allowed: tasks are executed by
+   *  threads, that wait for them(see TaskGroup)
+   */
+  explicit ThreadPool(std::size_t threads = default_threads());
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /** amount of workers */
+  std::size_t size() const noexcept;
+
+  /** amount of threads, that execute tasks while somebody waits for them
+   *  (workers and the waiting one)
+   */
+  std::size_t concurrency() const noexcept;
+
+  void submit(Task task);
+
+  /** executes one pending task in calling thread, false if there are none */
+  bool run_pending_task();
+
+  /** pool shared by parallel sortings by default, created on first use with
+   *  default_threads() workers
+   */
+  static ThreadPool &instance();
+
+  /** hardware concurrency less one for the thread, that waits for tasks */
+  static std::size_t default_threads() noexcept;
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;  ///< per worker + 1 external
+  std::vector<std::thread> workers_;
+
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::atomic<std::size_t> queued_{0};
+  bool stop_{false};
+
+  static thread_local ThreadPool *current_pool;
+  static thread_local std::size_t current_index;
+
+  friend class TaskGroup;
+
+  std::size_t own_queue() const noexcept;
+
+  /** blocks until a task is submitted or done() is true, done() is checked
+   *  under sleep_mutex_, so its change should be followed by notify_waiters()
+   */
+  template <typename Done>
+  void sleep_until(Done done);
+  void notify_waiters();
+
+  void work(std::size_t index);
+  bool pop(std::size_t index, Task &task);
+  bool steal(std::size_t start, Task &task);
+};
+
+/** set of tasks, that could be waited for together, waiting thread executes
+ *  pending tasks of the pool(so nested groups do not deadlock), first
+ *  exception thrown by a task is rethrown from wait()
+ */
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool &pool) : pool_{pool} {}
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  template <typename F>
+  void run(F &&func);
+
+  void wait();
+
+ private:
+  ThreadPool &pool_;
+  std::atomic<std::size_t> pending_{0};
+
+  /** executes pending tasks of the pool, sleeps, when there are none, until
+   *  the last task of the group is done
+   */
+  void join();
+
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+};
+
+inline thread_local ThreadPool *ThreadPool::current_pool = nullptr;
+inline thread_local std::size_t ThreadPool::current_index = 0;
+
+inline ThreadPool::ThreadPool(std::size_t threads) {
+  for (std::size_t i = 0; i <= threads; ++i) {
+    queues_.push_back(std::make_unique<Queue>());
+  }
+
+  workers_.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers_.emplace_back([this, i] { work(i); });
+  }
+}
+
+inline ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock{sleep_mutex_};
+    stop_ = true;
+  }
+  wake_.notify_all();
+
+  for (auto &worker : workers_) worker.join();
+}
+
+inline std::size_t ThreadPool::size() const noexcept {
+  return workers_.size();
+}
+
+inline std::size_t ThreadPool::concurrency() const noexcept {
+  return workers_.size() + 1;
+}
+
+inline void ThreadPool::submit(Task task) {
+  std::size_t index = own_queue();
+  {
+    std::lock_guard<std::mutex> lock{queues_[index]->mutex};
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock{sleep_mutex_};
+    ++queued_;
+  }
+  wake_.notify_one();
+}
+
+/** newest task of the own queue goes first, so waiting thread continues
+ *  depth first with its own subtasks, and tasks run inside its wait() do not
+ *  nest deeper than recursion of the tasks
+ */
+inline bool ThreadPool::run_pending_task() {
+  Task task;
+  std::size_t index = own_queue();
+
+  if (pop(index, task) || steal(index, task)) {
+    task();
+    return true;
+  }
+
+  return false;
+}
+
+/** queue of the worker, the last one for threads outside the pool */
+inline std::size_t ThreadPool::own_queue() const noexcept {
+  return current_pool == this ? current_index : queues_.size() - 1;
+}
+
+template <typename Done>
+void ThreadPool::sleep_until(Done done) {
+  std::unique_lock<std::mutex> lock{sleep_mutex_};
+  wake_.wait(lock, [this, &done] { return queued_ > 0 || done(); });
+}
+
+inline void ThreadPool::notify_waiters() {
+  {
+    // sleeper either has not checked done() yet, or already waits
+    std::lock_guard<std::mutex> lock{sleep_mutex_};
+  }
+  wake_.notify_all();
+}
+
+inline ThreadPool &ThreadPool::instance() {
+  static ThreadPool pool;
+  return pool;
+}
+
+inline std::size_t ThreadPool::default_threads() noexcept {
+  std::size_t hw = std::thread::hardware_concurrency();
+  return hw > 1 ? hw - 1 : 0;
+}
+
+inline void ThreadPool::work(std::size_t index) {
+  current_pool = this;
+  current_index = index;
+
+  while (true) {
+    if (run_pending_task()) continue;
+
+    std::unique_lock<std::mutex> lock{sleep_mutex_};
+    wake_.wait(lock, [this] { return stop_ || queued_ > 0; });
+    if (stop_ && queued_ == 0) return;
+  }
+}
+
+inline bool ThreadPool::pop(std::size_t index, Task &task) {
+  Queue &queue = *queues_[index];
+  std::lock_guard<std::mutex> lock{queue.mutex};
+  if (queue.tasks.empty()) return false;
+
+  task = std::move(queue.tasks.back());
+  queue.tasks.pop_back();
+  --queued_;
+  return true;
+}
+
+inline bool ThreadPool::steal(std::size_t start, Task &task) {
+  if (queued_ == 0) return false;
+
+  for (std::size_t i = 0; i < queues_.size(); ++i) {
+    Queue &queue = *queues_[(start + i) % queues_.size()];
+    std::lock_guard<std::mutex> lock{queue.mutex};
+    if (queue.tasks.empty()) continue;
+
+    task = std::move(queue.tasks.front());
+    queue.tasks.pop_front();
+    --queued_;
+    return true;
+  }
+
+  return false;
+}
+
+inline TaskGroup::~TaskGroup() {
+  // tasks reference the group, it could not go away before them
+  join();
+}
+
+template <typename F>
+void TaskGroup::run(F &&func) {
+  ++pending_;
+  try {
+    pool_.submit([this, func = std::forward<F>(func)]() mutable {
+      try {
+        func();
+      } catch (...) {
+        std::lock_guard<std::mutex> lock{error_mutex_};
+        if (!error_) error_ = std::current_exception();
+      }
+      // group could be destroyed by waiter right after the last decrement
+      ThreadPool &pool = pool_;
+      if (--pending_ == 0) pool.notify_waiters();
+    });
+  } catch (...) {
+    --pending_;
+    throw;
+  }
+}
+
+inline void TaskGroup::join() {
+  while (pending_ > 0) {
+    if (pool_.run_pending_task()) continue;
+    pool_.sleep_until([this] { return pending_ == 0; });
+  }
+}
+
+inline void TaskGroup::wait() {
+  join();
+
+  std::lock_guard<std::mutex> lock{error_mutex_};
+  if (error_) {
+    std::exception_ptr error = std::exchange(error_, nullptr);
+    std::rethrow_exception(error);
+  }
+}
+
+}  // namespace srtbch
+
+#endif  // SORT_BENCH_THREAD_POOL_HPP
@@ -31,6 +31,16 @@ class Generator : public std::mt19937 {
   }
 };
 
+/**
+ * Generates the same sequence of numbers for every object of the same type,
+ * use it to compare sortings on the same input arrays
+ */
+template <std::mt19937::result_type Seed = std::mt19937::default_seed>
+class SeededGenerator : public std::mt19937 {
+ public:
+  SeededGenerator() : std::mt19937{Seed} {}
+};
+
 }  // namespace srtbch
 
 #endif  // SORT_BENCH_UTILITY_HPP
@@ -0,0 +1,145 @@
+#include "catch.hpp"
+
+#include "sorting_benchmark/argsort.hpp"
+#include "sorting_benchmark/parallel_sortings.hpp"
+#include "sorting_benchmark/simd_sortings.hpp"
+#include "sorting_benchmark/sorting_benchmark.hpp"
+#include "sorting_benchmark/utility.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+using namespace srtbch;
+using namespace sortings;
+
+/** wide record, only key takes part in comparisons */
+struct WideRecord {
+  int key;
+  std::array<char, 248> payload;
+};
+
+struct WideRecordKey {
+  int operator()(const WideRecord& rec) const { return rec.key; }
+};
+
+/** argsort of keys with small range, ties should keep initial order */
+template <template <typename> typename SortFunctor>
+void require_argsorted(std::size_t size) {
+  Generator gen;
+  std::vector<int> arr(size);
+  for (auto& elem : arr) elem = static_cast<int>(gen() % 100) - 50;
+
+  std::vector<std::uint32_t> expected(size);
+  std::iota(expected.begin(), expected.end(), 0);
+  std::stable_sort(expected.begin(), expected.end(),
+                   [&arr](auto a, auto b) { return arr[a] < arr[b]; });
+
+  REQUIRE(argsort<SortFunctor>(arr.data(), arr.size()) == expected);
+}
+
+TEST_CASE("Argsort With Every Sorting", "[argsort]") {
+  std::size_t size = GENERATE(0, 1, 10, 1000, 100000);
+
+  require_argsorted<InsertionSort>(std::min<std::size_t>(size, 1000));
+  require_argsorted<NetworkSort>(std::min<std::size_t>(size, 32));
+  require_argsorted<MergeSort>(size);
+  require_argsorted<TimSort>(size);
+  require_argsorted<QuickSort>(size);
+  require_argsorted<PdqSort>(size);
+  require_argsorted<HeapSort>(size);
+  require_argsorted<RadixSort>(size);
+  require_argsorted<CountingSort>(size);
+  require_argsorted<BucketSort>(size);
+  require_argsorted<ParallelQuickSort>(size);
+  require_argsorted<ParallelRadixSort>(size);
+  require_argsorted<SimdSort>(size);
+}
+
+TEST_CASE("Apply Permutation", "[argsort]") {
+  std::size_t size = GENERATE(0, 1, 2, 100, 10000);
+  Generator gen;
+
+  std::vector<WideRecord> arr(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    arr[i].key = static_cast<int>(gen() % 1000);
+    arr[i].payload.fill(static_cast<char>(i));
+  }
+  auto expected{arr};
+
+  auto key_of = [](const WideRecord& rec) { return rec.key; };
+  auto perm{argsort<PdqSort>(arr.data(), arr.size(), key_of)};
+  for (std::size_t i = 0; i < size; ++i) expected[i] = arr[perm[i]];
+
+  apply_permutation(arr.data(), perm.data(), size);
+  for (std::size_t i = 0; i < size; ++i) {
+    REQUIRE(arr[i].key == expected[i].key);
+    REQUIRE(arr[i].payload == expected[i].payload);
+    REQUIRE(perm[i] == i);
+  }
+  REQUIRE(std::is_sorted(arr.begin(), arr.end(), [](auto& a, auto& b) {
+    return a.key < b.key;
+  }));
+}
+
+TEST_CASE("Indirect Sorting Array", "[sort][argsort]") {
+  SortBench<int, IndirectSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 1000, 100000);
+
+  auto stats{bench(size, 2)};
+
+  for (auto arr : bench.sorted_arrays()) {
+    REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
+  }
+  // keys in pairs are ArrayElement too, so their comparisons are counted
+  for (auto& [sz, tm, ca] : stats) REQUIRE(ca.cmp > 0);
+}
+
+TEST_CASE("Indirect Sorting Wide Records", "[sort][argsort]") {
+  std::size_t size = GENERATE(0, 1, 100, 10000);
+  Generator gen;
+
+  std::vector<WideRecord> arr(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    arr[i].key = static_cast<int>(gen() % 100);
+    arr[i].payload.fill(static_cast<char>(i));
+  }
+  auto expected{arr};
+  std::stable_sort(expected.begin(), expected.end(), [](auto& a, auto& b) {
+    return a.key < b.key;
+  });
+
+  // pairs hold int keys, not copies of records
+  static_assert(sizeof(IndexedKey<decltype(WideRecordKey{}(arr[0]))>) == 8);
+
+  SECTION("Comparison sorting") {
+    IndirectSort<WideRecord, QuickSort, WideRecordKey>{}(arr.data(), size);
+  }
+  SECTION("Radix sorting") {
+    IndirectSort<WideRecord, RadixSort, WideRecordKey>{}(arr.data(), size);
+  }
+  for (std::size_t i = 0; i < size; ++i) {
+    REQUIRE(arr[i].key == expected[i].key);
+    REQUIRE(arr[i].payload == expected[i].payload);
+  }
+}
+
+TEST_CASE("Apply Permutation Moves Every Element Once", "[argsort]") {
+  std::size_t size = GENERATE(1, 10, 1000, 100000);
+  Generator gen;
+
+  std::vector<ArrayElement<int>> arr(size);
+  for (auto& elem : arr) elem = static_cast<int>(gen());
+  auto perm{argsort<QuickSort>(arr.data(), arr.size())};
+
+  ArrayElement<int>::reset();
+  apply_permutation(arr.data(), perm.data(), size);
+  auto asgn = ArrayElement<int>::get_asgn();
+  ArrayElement<int>::reset();
+
+  REQUIRE(std::is_sorted(arr.begin(), arr.end()));
+  // one move per element and one more per cycle(to temporary)
+  REQUIRE(asgn <= size + size / 2);
+}
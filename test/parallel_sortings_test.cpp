@@ -0,0 +1,223 @@
+#include "catch.hpp"
+
+#include "sorting_benchmark/parallel_sortings.hpp"
+#include "sorting_benchmark/sorting_benchmark.hpp"
+#include "sorting_benchmark/thread_pool.hpp"
+#include "sorting_benchmark/utility.hpp"
+
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+using namespace srtbch;
+using namespace sortings;
+using namespace test;
+
+TEST_CASE("Parallel Merge Sorting Array", "[sort][parallel]") {
+  SortBench<int, ParallelMergeSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 1000, 100000);
+  std::size_t measure_num = GENERATE(1, 5);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Parallel Merge Sorting Stability", "[sort][parallel]") {
+  // small grain, so that parallel splits and merges happen
+  std::size_t threads = GENERATE(0, 1, 3, 8);
+  std::size_t size = GENERATE(1, 100, 10000, 100000);
+  ThreadPool pool{threads};
+
+  auto arr{generate_records(size)};
+  auto expected{arr};
+  std::stable_sort(std::begin(expected), std::end(expected));
+
+  ParallelMergeSort<Record>{pool, 64}(arr.data(), arr.size());
+  REQUIRE(arr == expected);
+}
+
+TEST_CASE("Parallel Quick Sorting Array", "[sort][parallel]") {
+  SortBench<int, ParallelQuickSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 1000, 100000);
+  std::size_t measure_num = GENERATE(1, 5);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Parallel Quick Sorting Partitions", "[sort][parallel]") {
+  // sizes above parallel_partition_threshold, few keys for equal pivots
+  std::size_t threads = GENERATE(0, 1, 3, 8);
+  std::size_t size = GENERATE(1000, 300000);
+  int keys = GENERATE(1, 3, 1000000);
+  ThreadPool pool{threads};
+
+  Generator gen;
+  std::vector<int> arr(size);
+  for (auto& elem : arr) elem = static_cast<int>(gen() % keys);
+  auto expected{arr};
+  std::sort(std::begin(expected), std::end(expected));
+
+  ParallelQuickSort<int>{pool, 64}(arr.data(), arr.size());
+  REQUIRE(arr == expected);
+}
+
+TEST_CASE("Parallel Quick Sorting Structured Input", "[sort][parallel]") {
+  // partitions of chunks of such inputs leave empty misplaced intervals
+  std::size_t threads = GENERATE(7, 8, 15);
+  std::size_t grain = GENERATE(std::size_t{64},
+                               ParallelQuickSort<int>::default_grain);
+  std::size_t size = std::size_t{1} << 20;
+  ThreadPool pool{threads};
+
+  std::vector<int> arr(size);
+  SECTION("Organ pipe") {
+    for (std::size_t i = 0; i < size; ++i) {
+      arr[i] = static_cast<int>(std::min(i, size - 1 - i));
+    }
+  }
+  SECTION("Sawtooth") {
+    for (std::size_t i = 0; i < size; ++i) arr[i] = static_cast<int>(i % 1000);
+  }
+  SECTION("Sorted blocks") {
+    // 16 blocks, ascending and descending in turn
+    std::size_t block = size / 16;
+    for (std::size_t i = 0; i < size; ++i) {
+      std::size_t pos = i % block;
+      arr[i] = static_cast<int>(i / block % 2 ? block - pos : pos);
+    }
+  }
+  auto expected{arr};
+  std::sort(std::begin(expected), std::end(expected));
+
+  ParallelQuickSort<int>{pool, grain}(arr.data(), arr.size());
+  REQUIRE(arr == expected);
+}
+
+TEST_CASE("Parallel Sample Sorting Array", "[sort][parallel]") {
+  SortBench<int, ParallelSampleSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 1000, 100000);
+  std::size_t measure_num = GENERATE(1, 5);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+  REQUIRE(bench.sort_functor().phase_times().size() == measure_num);
+}
+
+TEST_CASE("Parallel Sample Sorting Buckets", "[sort][parallel]") {
+  // small grain for many buckets, few keys for repeated splitters
+  std::size_t threads = GENERATE(0, 1, 3, 8);
+  std::size_t size = GENERATE(100, 1000, 300000);
+  int keys = GENERATE(1, 3, 100, 1000000);
+  ThreadPool pool{threads};
+
+  Generator gen;
+  std::vector<int> arr(size);
+  for (auto& elem : arr) elem = static_cast<int>(gen() % keys);
+  auto expected{arr};
+  std::sort(std::begin(expected), std::end(expected));
+
+  ParallelSampleSort<int> sort{pool, 16};
+  sort(arr.data(), arr.size());
+  REQUIRE(arr == expected);
+
+  REQUIRE(sort.phase_times().size() == 1);
+  auto times{sort.phase_times().front()};
+  REQUIRE(times.bucket_sorting.count() > 0);
+  REQUIRE(times.classification.count() > 0);
+}
+
+TEST_CASE("Parallel Radix Sorting Array", "[sort][parallel][radix]") {
+  SortBench<int, ParallelRadixSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 1000, 100000);
+  std::size_t measure_num = GENERATE(1, 5);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Non Temporal Radix Sorting Array", "[sort][parallel][radix]") {
+  SortBench<std::uint64_t, NonTemporalRadixSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 1000, 100000);
+
+  bench(size, 2);
+
+  require_sorted(bench);
+}
+
+TEMPLATE_TEST_CASE("Parallel Radix Sorting Key Widths",
+                   "[sort][parallel][radix]", std::int8_t, std::int16_t,
+                   std::uint32_t, std::int64_t, std::uint64_t) {
+  // small grain, so that chunks are shorter than write-combining lines
+  std::size_t threads = GENERATE(0, 3, 8);
+  std::size_t size = GENERATE(100, 1000, 100000);
+  ThreadPool pool{threads};
+
+  Generator gen;
+  std::vector<TestType> arr(size);
+  for (auto& elem : arr) elem = static_cast<TestType>(gen() * 2654435761u);
+  auto expected{arr};
+  std::sort(std::begin(expected), std::end(expected));
+
+  SECTION("Regular stores") {
+    ParallelRadixSort<TestType>{pool, 8}(arr.data(), arr.size());
+    REQUIRE(arr == expected);
+  }
+
+  SECTION("Non-temporal stores") {
+    NonTemporalRadixSort<TestType>{pool, 8}(arr.data(), arr.size());
+    REQUIRE(arr == expected);
+  }
+}
+
+TEST_CASE("Segmented Sorting Array", "[sort][parallel][segmented]") {
+  SortBench<int, SegmentedSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 1000, 300000);
+
+  bench(size, 2);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Segmented Sorting Ragged Segments", "[sort][parallel][segmented]") {
+  // every size class, empty segments and huge ones between small ones, one
+  // of the huge ones is organ pipe, partitioned in parallel by many threads
+  std::size_t threads = GENERATE(0, 1, 3, 8, 15);
+  std::size_t grain = GENERATE(std::size_t{64},
+                               SegmentedSort<int>::default_grain);
+  ThreadPool pool{threads};
+
+  constexpr std::size_t organ_pipe = 12;
+  std::vector<std::size_t> offsets{0};
+  for (std::size_t size : {0, 1, 2, 7, 32, 33, 1000, 200000, 5, 0, 50000,
+                           300000, 1 << 20, 31, 3}) {
+    offsets.push_back(offsets.back() + size);
+  }
+  for (std::size_t i = 0; i < 1000; ++i) {
+    offsets.push_back(offsets.back() + i % 100);
+  }
+
+  Generator gen;
+  std::vector<int> arr(offsets.back());
+  for (auto& elem : arr) elem = static_cast<int>(gen() % 1000);
+  std::size_t first = offsets[organ_pipe], last = offsets[organ_pipe + 1];
+  for (std::size_t i = first; i < last; ++i) {
+    arr[i] = static_cast<int>(std::min(i - first, last - 1 - i));
+  }
+  auto expected{arr};
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    std::sort(expected.begin() + offsets[i], expected.begin() + offsets[i + 1]);
+  }
+
+  SegmentedSort<int>{pool, grain}(arr.data(), offsets.data(),
+                                  offsets.size() - 1);
+  REQUIRE(arr == expected);
+}
@@ -0,0 +1,58 @@
+#include "catch.hpp"
+
+#include "sorting_benchmark/simd_sortings.hpp"
+#include "sorting_benchmark/sorting_benchmark.hpp"
+#include "sorting_benchmark/utility.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+using namespace srtbch;
+using namespace sortings;
+
+TEST_CASE("Simd Sorting Array", "[sort][simd]") {
+  SortBench<int, SimdSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 100000);
+  std::size_t measure_num = GENERATE(1, 5);
+
+  bench(size, measure_num);
+
+  auto before{bench.notsorted_arrays()};
+  auto after{bench.sorted_arrays()};
+  for (std::size_t i = 0; i < after.size(); ++i) {
+    std::sort(std::begin(before[i]), std::end(before[i]));
+    REQUIRE(before[i] == after[i]);
+  }
+}
+
+TEMPLATE_TEST_CASE("Simd Sorting Key Types", "[sort][simd]", std::int32_t,
+                   std::uint32_t, float, std::int64_t, double) {
+  // every supported instruction set, sizes around vector and network sizes
+  auto level = GENERATE(SimdLevel::scalar, SimdLevel::avx2, SimdLevel::avx512);
+  std::size_t size = GENERATE(0, 1, 2, 7, 8, 9, 63, 64, 65, 129, 255, 256,
+                              257, 1000, 100000);
+  std::uint32_t keys = GENERATE(2u, 1000u, 0u);  // 0 - full range
+
+  SimdSort<TestType> sort{level};
+  REQUIRE(sort.level() <= level);
+  REQUIRE(sort.level() <= SimdSort<TestType>::supported_level());
+
+  Generator gen;
+  std::vector<TestType> arr(size);
+  for (auto& elem : arr) {
+    auto value = static_cast<std::int64_t>(gen()) - (1ll << 31);
+    if (keys != 0) value %= keys;
+    elem = static_cast<TestType>(value);
+  }
+  auto expected{arr};
+  std::sort(std::begin(expected), std::end(expected));
+
+  sort(arr.data(), arr.size());
+  REQUIRE(arr == expected);
+}
+
+TEST_CASE("Simd Sorting Unsupported Types", "[sort][simd]") {
+  REQUIRE(SimdSort<std::int16_t>{}.level() == SimdLevel::scalar);
+  REQUIRE(SimdSort<ArrayElement<int>>{}.level() == SimdLevel::scalar);
+}
@@ -52,4 +52,72 @@ TEST_CASE("Not Kept Arrays Throw", "[sort][throw]") {
   REQUIRE_THROWS_WITH(
       bench.sorted_arrays(),
       "Call keep_after(), and than operator() to get this arrays");
-}
\ No newline at end of file
+}
+
+template <typename T>
+struct NoSort {
+  void operator()(T*, std::size_t) const {}
+};
+
+TEST_CASE("Large Mode", "[sort][large mode]") {
+  SortBench<int, QuickSort, Generator> bench;
+  bench.large_mode();
+
+  auto stats{bench(1000, 3)};
+  REQUIRE(stats.size() == 3);
+  for (auto& [sz, tm, ca] : stats) {
+    REQUIRE(sz == 1000);
+    REQUIRE(ca.cmp == 0);
+    REQUIRE(ca.asgn == 0);
+  }
+
+  SortBench<int, NoSort, Generator> no_sort_bench{false, true};
+  auto no_sort_stats{no_sort_bench(1000, 3)};
+  REQUIRE(no_sort_stats.size() == 3);
+  for (auto& [sz, tm, ca] : no_sort_stats) {
+    REQUIRE(ca.cmp == 0);
+    REQUIRE(ca.asgn == 0);
+  }
+  for (auto arr : no_sort_bench.sorted_arrays()) {
+    REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == false);
+  }
+
+  no_sort_bench.large_mode();
+  REQUIRE_THROWS_WITH(no_sort_bench(1000, 1),
+                      "Array is not sorted by SortFunctor");
+}
+
+TEST_CASE("Batch Mode", "[sort][batch mode]") {
+  // small networks, up to 32 elements, and merged ones, 33-64 elements
+  std::size_t min_size = GENERATE(4, 8, 33);
+  std::size_t max_size = min_size == 33 ? 64 : 4 * min_size;
+  SortBench<int, BatchSort, Generator> bench{false, true};
+  bench.batch_mode(min_size, max_size);
+
+  auto stats{bench(10000, 3)};
+  REQUIRE(stats.size() == 3);
+  REQUIRE(bench.segments_per_second().size() == 3);
+  for (auto rate : bench.segments_per_second()) REQUIRE(rate > 0);
+
+  const auto& offsets = bench.segment_offsets();
+  REQUIRE(offsets.front() == 0);
+  REQUIRE(offsets.back() == 10000);
+  for (std::size_t i = 0; i + 2 < offsets.size(); ++i) {
+    REQUIRE(offsets[i + 1] - offsets[i] >= min_size);
+    REQUIRE(offsets[i + 1] - offsets[i] <= max_size);
+  }
+
+  auto arr{bench.sorted_arrays().back()};
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    REQUIRE(std::is_sorted(arr.begin() + offsets[i],
+                           arr.begin() + offsets[i + 1]));
+  }
+
+  SortBench<int, InsertionSort, Generator> loop_bench;
+  loop_bench.batch_mode(1, 8);
+  loop_bench.large_mode();
+  REQUIRE_NOTHROW(loop_bench(100, 2));
+
+  REQUIRE_THROWS_AS(bench.batch_mode(0, 8), std::invalid_argument);
+  REQUIRE_THROWS_AS(bench.batch_mode(9, 8), std::invalid_argument);
+}
@@ -4,10 +4,45 @@
 #include "sorting_benchmark/sortings.hpp"
 #include "sorting_benchmark/utility.hpp"
 
+#include "test_helpers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
 #include <utility>
+#include <vector>
 
 using namespace srtbch;
 using namespace sortings;
+using namespace test;
+
+/** generates keys from the small range, [0, 100) */
+struct SmallRangeGenerator : Generator {
+  result_type operator()() { return Generator::operator()() % 100; }
+};
+
+/** generates already sorted sequence, 0, 1, 2, ... */
+struct AscendingGenerator {
+  std::size_t next{0};
+  std::size_t operator()() { return next++; }
+};
+
+/** generates mostly sorted sequence, every 100th element is random */
+struct NearlySortedGenerator : Generator {
+  int next{0};
+  int operator()() {
+    ++next;
+    auto rnd = Generator::operator()();
+    return rnd % 100 == 0 ? static_cast<int>(rnd) : next;
+  }
+};
+
+/** generates reverse sorted sequence, -1, -2, -3, ... */
+struct DescendingGenerator {
+  int next{0};
+  int operator()() { return --next; }
+};
 
 TEST_CASE("Selection Sorting Array", "[sort]") {
   SortBench<int, SelectionSort, Generator> bench{true, true};
@@ -16,9 +51,7 @@ TEST_CASE("Selection Sorting Array", "[sort]") {
 
   bench(size, measure_num);
 
-  for (auto arr : bench.sorted_arrays()) {
-    REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
-  }
+  require_sorted(bench);
 }
 
 TEST_CASE("Bubble Sorting Array", "[sort]") {
@@ -28,9 +61,7 @@ TEST_CASE("Bubble Sorting Array", "[sort]") {
 
   bench(size, measure_num);
 
-  for (auto arr : bench.sorted_arrays()) {
-    REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
-  }
+  require_sorted(bench);
 }
 
 
@@ -41,8 +72,50 @@ TEST_CASE("Insertion Sorting Array", "[sort]") {
 
   bench(size, measure_num);
 
-  for (auto arr : bench.sorted_arrays()) {
-    REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
+  require_sorted(bench);
+}
+
+TEST_CASE("Binary Insertion Sorting Array", "[sort]") {
+  SortBench<int, BinaryInsertionSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Shell Sorting Array", "[sort]") {
+  SortBench<int, CiuraShellSort, Generator> ciura_bench{true, true};
+  SortBench<int, TokudaShellSort, Generator> tokuda_bench{true, true};
+  SortBench<int, SedgewickShellSort, Generator> sedgewick_bench{true, true};
+  SortBench<int, PrattShellSort, Generator> pratt_bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  ciura_bench(size, measure_num);
+  tokuda_bench(size, measure_num);
+  sedgewick_bench(size, measure_num);
+  pratt_bench(size, measure_num);
+
+  require_sorted(ciura_bench);
+  require_sorted(tokuda_bench);
+  require_sorted(sedgewick_bench);
+  require_sorted(pratt_bench);
+}
+
+TEST_CASE("Shell Sorting Same Input", "[sort][shell]") {
+  // seeded generator gives the same arrays to every gap sequence
+  SortBench<int, CiuraShellSort, SeededGenerator<>> ciura_bench{true, false};
+  SortBench<int, PrattShellSort, SeededGenerator<>> pratt_bench{true, false};
+
+  auto ciura_stats{ciura_bench(1000, 3)};
+  auto pratt_stats{pratt_bench(1000, 3)};
+
+  REQUIRE(ciura_bench.notsorted_arrays() == pratt_bench.notsorted_arrays());
+  for (std::size_t i = 0; i < ciura_stats.size(); ++i) {
+    // Pratt's sequence is much longer, so it takes more comparisons
+    REQUIRE(std::get<2>(ciura_stats[i]).cmp < std::get<2>(pratt_stats[i]).cmp);
   }
 }
 
@@ -53,8 +126,83 @@ TEST_CASE("Merge Sorting Array", "[sort]") {
 
   bench(size, measure_num);
 
-  for (auto arr : bench.sorted_arrays()) {
-    REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
+  require_sorted(bench);
+}
+
+TEST_CASE("Bottom Up Merge Sorting Array", "[sort]") {
+  SortBench<int, BottomUpMergeSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("In Place Merge Sorting Array", "[sort]") {
+  SortBench<int, InPlaceMergeSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("In Place Merge Sorting With External Buffer", "[sort][merge]") {
+  std::size_t size = GENERATE(1, 2, 3, 10, 1000, 10000);
+  std::size_t capacity = GENERATE(0, 1, 16, 300);
+  auto arr{generate_records(size)};
+
+  auto expected{arr};
+  std::stable_sort(std::begin(expected), std::end(expected));
+
+  std::vector<Record> buffer(capacity);
+  InPlaceMergeSort<Record>{buffer.data(), capacity}(arr.data(), arr.size());
+  REQUIRE(arr == expected);
+}
+
+TEST_CASE("Tim Sorting Array", "[sort]") {
+  SortBench<int, TimSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Tim Sorting Patterns", "[sort][tim]") {
+  std::size_t size = GENERATE(100, 1000, static_cast<std::size_t>(1e5));
+
+  SortBench<int, TimSort, AscendingGenerator> asc_bench{true, true};
+  SortBench<int, TimSort, DescendingGenerator> desc_bench{true, true};
+  SortBench<int, TimSort, SmallRangeGenerator> dup_bench{true, true};
+  SortBench<int, TimSort, NearlySortedGenerator> nearly_bench{true, true};
+
+  auto asc_stats{asc_bench(size, 1)};
+  desc_bench(size, 1);
+  dup_bench(size, 1);
+  nearly_bench(size, 1);
+
+  require_sorted(asc_bench);
+  require_sorted(desc_bench);
+  require_sorted(dup_bench);
+  require_sorted(nearly_bench);
+
+  // one natural run, nothing to merge
+  REQUIRE(std::get<2>(asc_stats[0]).cmp == size - 1);
+}
+
+TEST_CASE("Tim Sorting Stability", "[sort][tim]") {
+  std::size_t size = GENERATE(10, 1000, static_cast<std::size_t>(1e5));
+  auto arr{generate_records(size)};
+
+  TimSort<Record>{}(arr.data(), arr.size());
+
+  for (std::size_t i = 1; i < size; ++i) {
+    REQUIRE(!(arr[i].key < arr[i - 1].key));
+    if (arr[i].key == arr[i - 1].key) REQUIRE(arr[i - 1].index < arr[i].index);
   }
 }
 
@@ -65,9 +213,115 @@ TEST_CASE("Quick Sorting Array", "[sort]") {
 
   bench(size, measure_num);
 
-  for (auto arr : bench.sorted_arrays()) {
-    REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
-  }
+  require_sorted(bench);
+}
+
+TEST_CASE("Quick Sorting Ordered Array", "[sort][quick]") {
+  // used to overflow the stack with quadratic recursion depth
+  SortBench<int, QuickSort, AscendingGenerator> asc_bench{true, true};
+  SortBench<int, QuickSort, DescendingGenerator> desc_bench{true, true};
+
+  asc_bench(static_cast<std::size_t>(1e6), 1);
+  desc_bench(static_cast<std::size_t>(1e6), 1);
+
+  require_sorted(asc_bench);
+  require_sorted(desc_bench);
+}
+
+TEST_CASE("Three Way Quick Sorting Array", "[sort]") {
+  SortBench<int, ThreeWayQuickSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Three Way Quick Sorting Patterns", "[sort][three way]") {
+  std::size_t size = GENERATE(100, 1000, static_cast<std::size_t>(1e5));
+
+  SortBench<int, ThreeWayQuickSort, AscendingGenerator> asc_bench{true, true};
+  SortBench<int, ThreeWayQuickSort, DescendingGenerator> desc_bench{true, true};
+  SortBench<int, ThreeWayQuickSort, SmallRangeGenerator> dup_bench{true, true};
+
+  asc_bench(size, 1);
+  desc_bench(size, 1);
+  dup_bench(size, 1);
+
+  require_sorted(asc_bench);
+  require_sorted(desc_bench);
+  require_sorted(dup_bench);
+}
+
+TEST_CASE("Three Way Quick Sorting Without Equality", "[sort][three way]") {
+  // keys from the small range, equal ones are gathered without operator==
+  struct LessOnly {
+    int key;
+    bool operator<(const LessOnly& other) const { return key < other.key; }
+    bool operator>(const LessOnly& other) const { return key > other.key; }
+  };
+
+  std::size_t size = GENERATE(10, 1000, static_cast<std::size_t>(1e5));
+  Generator gen;
+  std::vector<LessOnly> arr(size);
+  for (auto& elem : arr) elem.key = static_cast<int>(gen() % 10);
+
+  ThreeWayQuickSort<LessOnly>{}(arr.data(), arr.size());
+  REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)));
+}
+
+TEST_CASE("Dual Pivot Quick Sorting Array", "[sort]") {
+  SortBench<int, DualPivotQuickSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Dual Pivot Quick Sorting Patterns", "[sort][dual pivot]") {
+  std::size_t size = GENERATE(100, 1000, static_cast<std::size_t>(1e5));
+
+  SortBench<int, DualPivotQuickSort, AscendingGenerator> asc_bench{true, true};
+  SortBench<int, DualPivotQuickSort, DescendingGenerator> desc_bench{true,
+                                                                     true};
+  SortBench<int, DualPivotQuickSort, SmallRangeGenerator> dup_bench{true, true};
+
+  asc_bench(size, 1);
+  desc_bench(size, 1);
+  dup_bench(size, 1);
+
+  require_sorted(asc_bench);
+  require_sorted(desc_bench);
+  require_sorted(dup_bench);
+}
+
+TEST_CASE("Pdq Sorting Array", "[sort]") {
+  SortBench<int, PdqSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Pdq Sorting Patterns", "[sort][pdq]") {
+  std::size_t size = GENERATE(100, 1000, static_cast<std::size_t>(1e5));
+
+  SortBench<int, PdqSort, AscendingGenerator> asc_bench{true, true};
+  SortBench<int, PdqSort, DescendingGenerator> desc_bench{true, true};
+  SortBench<int, PdqSort, SmallRangeGenerator> dup_bench{true, true};
+
+  asc_bench(size, 1);
+  desc_bench(size, 1);
+  dup_bench(size, 1);
+
+  require_sorted(asc_bench);
+  require_sorted(desc_bench);
+  require_sorted(dup_bench);
 }
 
 TEST_CASE("Heap Sorting Array", "[sort]") {
@@ -77,7 +331,218 @@ TEST_CASE("Heap Sorting Array", "[sort]") {
 
   bench(size, measure_num);
 
-  for (auto arr : bench.sorted_arrays()) {
+  require_sorted(bench);
+}
+
+TEST_CASE("Heap Sorting Comparisons And Assignments", "[sort][heap]") {
+  // Floyd's bounce takes about n * log2(n) comparisons and assignments,
+  // swapping sift-down takes about twice as much
+  SortBench<int, HeapSort, Generator> bench;
+  std::size_t size = GENERATE(1000, 10000, 100000);
+
+  for (auto& [sz, tm, ca] : bench(size, 3)) {
+    double nlogn = static_cast<double>(sz) * std::log2(sz);
+    REQUIRE(ca.cmp < 1.5 * nlogn);
+    REQUIRE(ca.asgn < 1.5 * nlogn);
+  }
+}
+
+TEST_CASE("Radix Sorting Array", "[sort]") {
+  SortBench<int, RadixSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEMPLATE_TEST_CASE("Radix Sorting Key Widths", "[sort][radix]", std::int8_t,
+                   std::uint8_t, std::int16_t, std::uint32_t, std::int64_t,
+                   std::uint64_t) {
+  SortBench<TestType, RadixSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(0, 1, 2, 1000);
+
+  bench(size, 5);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Quaternary Heap Sorting Array", "[sort]") {
+  SortBench<int, QuaternaryHeapSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Octonary Heap Sorting Array", "[sort]") {
+  SortBench<int, OctonaryHeapSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("D-ary Heap Sorting Unaligned Array", "[sort][heap]") {
+  // every start offset gives different amount of elements before the heap
+  std::size_t offset = GENERATE(range(0, 8));
+  Generator gen;
+  std::vector<std::int16_t> arr(1000 + offset);
+  std::generate(std::begin(arr), std::end(arr), std::ref(gen));
+
+  std::vector<std::int16_t> expected(std::begin(arr) + offset, std::end(arr));
+  std::sort(std::begin(expected), std::end(expected));
+
+  DaryHeapSort<std::int16_t, 8>{}(arr.data() + offset, arr.size() - offset);
+  REQUIRE(std::equal(std::begin(arr) + offset, std::end(arr),
+                     std::begin(expected)));
+}
+
+TEST_CASE("Counting Sorting Array", "[sort]") {
+  SortBench<int, CountingSort, Generator> bench{true, true};
+  SortBench<int, CountingSort, SmallRangeGenerator> small_bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+  small_bench(size, measure_num);
+
+  require_sorted(bench);
+  require_sorted(small_bench);
+}
+
+TEST_CASE("Bucket Sorting Array", "[sort]") {
+  SortBench<int, BucketSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 50, 100, 1000, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEMPLATE_TEST_CASE("Bucket Sorting Key Types", "[sort][bucket]", float, double,
+                   std::uint_fast32_t) {
+  SortBench<TestType, BucketSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(0, 1, 2, 1000);
+
+  bench(size, 5);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Merge Sorting With External Buffer", "[sort][merge]") {
+  std::size_t size = GENERATE(1, 2, 3, 10, 1000);
+  Generator gen;
+  std::vector<int> arr(size);
+  std::generate(std::begin(arr), std::end(arr), std::ref(gen));
+
+  SECTION("Enough capacity") {
+    std::vector<int> buffer(MergeSort<int>::scratch_size(size));
+    MergeSort<int>{buffer.data(), buffer.size()}(arr.data(), arr.size());
+    REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
+  }
+
+  SECTION("Not enough capacity") {
+    int buffer[1];
+    MergeSort<int>{buffer, 0}(arr.data(), arr.size());
     REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
   }
 }
+
+TEST_CASE("Network Sorting Array", "[sort][network]") {
+  SortBench<int, NetworkSort, Generator> bench{true, true};
+  std::size_t size = GENERATE(3, 10, 16, 31, 32, 33, 1000);
+  std::size_t measure_num = GENERATE(1, 5, 10);
+
+  bench(size, measure_num);
+
+  require_sorted(bench);
+}
+
+TEST_CASE("Network Sorting Every Size", "[sort][network]") {
+  std::size_t keys = GENERATE(2, 5, 1000000);
+  Generator gen;
+
+  for (std::size_t size = 0; size <= NetworkSort<int>::max_size; ++size) {
+    std::vector<int> arr(size);
+    for (auto& elem : arr) elem = static_cast<int>(gen() % keys);
+    auto expected{arr};
+    std::sort(std::begin(expected), std::end(expected));
+
+    NetworkSort<int>{}(arr.data(), arr.size());
+    REQUIRE(arr == expected);
+  }
+}
+
+TEST_CASE("Sorting Network Sizes", "[sort][network]") {
+  // optimal amounts of comparators
+  REQUIRE(SortingNetwork<int, 2>::size == 1);
+  REQUIRE(SortingNetwork<int, 4>::size == 5);
+  REQUIRE(SortingNetwork<int, 6>::size == 12);
+  REQUIRE(SortingNetwork<int, 8>::size == 19);
+  // Batcher's network for 64 elements
+  REQUIRE(SortingNetwork<int, 64>::size == 543);
+
+  // every comparator is counted once
+  std::vector<ArrayElement<int>> arr{7, 3, 5, 1, 6, 2, 8, 4};
+  ArrayElement<int>::reset();
+  SortingNetwork<ArrayElement<int>, 8>{}(arr.data());
+  REQUIRE(ArrayElement<int>::get_cmp() == 19);
+  REQUIRE(std::is_sorted(std::begin(arr), std::end(arr)) == true);
+  ArrayElement<int>::reset();
+}
+
+TEST_CASE("Batch Sorting Segments", "[sort][batch]") {
+  Generator gen;
+  std::vector<std::size_t> offsets{0};
+  // networks up to 64 elements, QuickSort above
+  for (std::size_t size = 0; size <= 70; ++size) {
+    offsets.push_back(offsets.back() + size);
+  }
+  offsets.push_back(offsets.back() + 1000);
+
+  std::vector<int> arr(offsets.back());
+  for (auto& elem : arr) elem = static_cast<int>(gen() % 100);
+  auto expected{arr};
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    std::sort(expected.begin() + offsets[i], expected.begin() + offsets[i + 1]);
+  }
+
+  BatchSort<int>{}(arr.data(), offsets.data(), offsets.size() - 1);
+  REQUIRE(arr == expected);
+}
+
+TEST_CASE("Sorting Above 2^31 Elements", "[.][sort][large]") {
+  // hidden, run explicitly with "[large]" on machine with >= 4GB of free RAM
+  const std::size_t size = (std::size_t{1} << 31) + 1000;
+
+  SECTION("Quick Sort") {
+    SortBench<std::uint8_t, QuickSort, Generator> bench;
+    bench.large_mode();
+    REQUIRE_NOTHROW(bench(size, 1));
+  }
+
+  SECTION("Heap Sort") {
+    SortBench<std::uint8_t, HeapSort, Generator> bench;
+    bench.large_mode();
+    REQUIRE_NOTHROW(bench(size, 1));
+  }
+
+  SECTION("Merge Sort") {
+    SortBench<std::uint8_t, MergeSort, Generator> bench;
+    bench.large_mode();
+    REQUIRE_NOTHROW(bench(size, 1));
+  }
+
+  SECTION("Radix Sort") {
+    SortBench<std::uint8_t, RadixSort, Generator> bench;
+    bench.large_mode();
+    REQUIRE_NOTHROW(bench(size, 1));
+  }
+}
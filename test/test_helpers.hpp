@@ -0,0 +1,64 @@
+/** @file
+ *  checkers and element types shared by tests
+ */
+
+#ifndef SORT_BENCH_TEST_HELPERS_HPP
+#define SORT_BENCH_TEST_HELPERS_HPP
+
+#include "catch.hpp"
+
+#include "sorting_benchmark/utility.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace srtbch {
+
+namespace test {
+
+/** checks, that every kept sorted array is sorted permutation of its
+ *  notsorted one
+ */
+template <typename Bench>
+void require_sorted(Bench& bench) {
+  auto before{bench.notsorted_arrays()};
+  auto after{bench.sorted_arrays()};
+  REQUIRE(before.size() == after.size());
+
+  for (std::size_t i = 0; i < after.size(); ++i) {
+    REQUIRE(std::is_sorted(std::begin(after[i]), std::end(after[i])) == true);
+
+    std::sort(std::begin(before[i]), std::end(before[i]));
+    REQUIRE(before[i] == after[i]);
+  }
+}
+
+/** compared by key only, index keeps initial order to check stability */
+struct Record {
+  int key;
+  std::size_t index;
+
+  bool operator<(const Record& other) const { return key < other.key; }
+  bool operator>(const Record& other) const { return key > other.key; }
+  bool operator<=(const Record& other) const { return key <= other.key; }
+  bool operator==(const Record& other) const {
+    return key == other.key && index == other.index;
+  }
+};
+
+/** records with keys from the small range, [0, 100), so stability matters */
+inline std::vector<Record> generate_records(std::size_t size) {
+  Generator gen;
+  std::vector<Record> arr(size);
+  for (std::size_t i = 0; i < size; ++i) {
+    arr[i] = {static_cast<int>(gen() % 100), i};
+  }
+  return arr;
+}
+
+}  // namespace test
+
+}  // namespace srtbch
+
+#endif  // SORT_BENCH_TEST_HELPERS_HPP
@@ -0,0 +1,116 @@
+#include "catch.hpp"
+
+#include "sorting_benchmark/thread_pool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+using namespace srtbch;
+
+TEST_CASE("Thread Pool Runs All Tasks", "[thread pool]") {
+  std::size_t threads = GENERATE(0, 1, 4);
+  ThreadPool pool{threads};
+  REQUIRE(pool.size() == threads);
+  REQUIRE(pool.concurrency() == threads + 1);
+
+  std::atomic<std::size_t> done{0};
+  TaskGroup group{pool};
+  for (std::size_t i = 0; i < 1000; ++i) {
+    group.run([&done] { ++done; });
+  }
+  group.wait();
+
+  REQUIRE(done == 1000);
+}
+
+TEST_CASE("Thread Pool Nested Groups", "[thread pool]") {
+  // every task waits for its own subtasks, waiting threads help with them
+  std::size_t threads = GENERATE(0, 1, 4);
+  ThreadPool pool{threads};
+  std::atomic<std::size_t> leaves{0};
+
+  std::function<void(std::size_t)> fork = [&](std::size_t depth) {
+    if (depth == 0) {
+      ++leaves;
+      return;
+    }
+
+    TaskGroup group{pool};
+    group.run([&fork, depth] { fork(depth - 1); });
+    fork(depth - 1);
+    group.wait();
+  };
+  fork(10);
+
+  REQUIRE(leaves == 1024);
+}
+
+TEST_CASE("Waiting Thread Runs Own Tasks First", "[thread pool]") {
+  // without workers every task runs inside some wait(), taking the oldest
+  // ones would nest them as deep as there are tasks
+  ThreadPool pool{0};
+  std::size_t nesting = 0, max_nesting = 0;
+
+  std::function<void(std::size_t)> fork = [&](std::size_t depth) {
+    max_nesting = std::max(max_nesting, ++nesting);
+    if (depth > 0) {
+      TaskGroup group{pool};
+      group.run([&fork, depth] { fork(depth - 1); });
+      fork(depth - 1);
+      group.wait();
+    }
+    --nesting;
+  };
+  fork(14);
+
+  REQUIRE(max_nesting == 15);
+}
+
+TEST_CASE("Task Group Rethrows Exception", "[thread pool][throw]") {
+  ThreadPool pool{2};
+  std::atomic<std::size_t> done{0};
+
+  TaskGroup group{pool};
+  group.run([] { throw std::runtime_error{"task failed"}; });
+  for (std::size_t i = 0; i < 10; ++i) {
+    group.run([&done] { ++done; });
+  }
+
+  REQUIRE_THROWS_WITH(group.wait(), "task failed");
+  REQUIRE(done == 10);
+  REQUIRE_NOTHROW(group.wait());
+}
+
+TEST_CASE("Sleeping Waiter Wakes Up For New Tasks", "[thread pool]") {
+  ThreadPool pool{1};
+  std::atomic<bool> started{false};
+  std::atomic<bool> done{false};
+  std::thread::id runner;
+
+  TaskGroup group{pool};
+  // the only worker is busy, the task submitted later could be executed
+  // only by waiting thread
+  group.run([&] {
+    started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds{20});
+    group.run([&] {
+      runner = std::this_thread::get_id();
+      done = true;
+    });
+    while (!done) std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  });
+  while (!started) std::this_thread::yield();
+  group.wait();
+
+  REQUIRE(runner == std::this_thread::get_id());
+
+  // group goes away right after the last task of the worker is done
+  for (std::size_t i = 0; i < 100; ++i) {
+    TaskGroup short_group{pool};
+    short_group.run([] {});
+  }
+}
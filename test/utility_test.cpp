@@ -7,3 +7,15 @@
 
 using namespace srtbch;
 
+TEST_CASE("Seeded Generator Repeats Sequence", "[generator]") {
+  SeededGenerator<42> gen1, gen2;
+  SeededGenerator<43> gen3;
+
+  std::array<SeededGenerator<>::result_type, 100> arr1, arr2, arr3;
+  std::generate(std::begin(arr1), std::end(arr1), std::ref(gen1));
+  std::generate(std::begin(arr2), std::end(arr2), std::ref(gen2));
+  std::generate(std::begin(arr3), std::end(arr3), std::ref(gen3));
+
+  REQUIRE(arr1 == arr2);
+  REQUIRE(arr1 != arr3);
+}